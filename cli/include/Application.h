@@ -47,17 +47,28 @@ private:
     bool ping() const;
     bool createChain(const size_t chainId, const std::string& data) const;
     bool removeChain(const size_t chainId) const;
+    bool backupChain(const size_t chainId, const std::string& path) const;
+    bool cloneChain(const size_t chainId, const size_t targetChainId) const;
     bool addBlock(const size_t chainId, const std::string& data) const;
+    bool addLargeBlock(const size_t chainId, const std::string& data, const std::string& path) const;
+    bool downloadBlock(const size_t chainId, const size_t blockId, const std::string& path) const;
+    bool importBlocks(const size_t chainId, const std::string& path) const;
     bool getBlock(const size_t chainId, const size_t blockId) const;
+    bool getBlockByHash(const size_t chainId, const std::string& hash) const;
     bool getBlocks(const size_t chainId) const;
+    bool getBlocksByIndex(const size_t chainId, const std::string& indices) const;
     bool verifyChain(const size_t chainId) const;
+    bool setRetention(const size_t chainId, const size_t retainBlocks, const uint64_t retainAge) const;
     bool getChainHeader(const size_t chainId) const;
     bool getChainKeys(const size_t chainId) const;
     bool getChainInfo(const size_t chainId) const;
+    bool listChains(const size_t startId) const;
+    bool getStats() const;
 
     void setAuthData(Service::IPC::AuthData* data) const;
 
     bool processRequest(const Service::IPC::Request& req) const;
+    bool processRequest(const Service::IPC::Request& req, Service::IPC::Response& resp) const;
 
     void initializeLogger() const;
 
@@ -70,19 +81,45 @@ private:
     bool _isPingRequest;
     bool _isCreateChainRequest;
     bool _isRemoveChainRequest;
+    bool _isBackupChainRequest;
+    bool _isCloneChainRequest;
     bool _isAddBlockRequest;
+    bool _isImportBlocksRequest;
     bool _isGetBlockRequest;
+    bool _isDownloadBlockRequest;
+    bool _isGetBlockByHashRequest;
     bool _isGetBlocksRequest;
+    bool _isGetBlocksByIndexRequest;
     bool _isVerifyChainRequest;
+    bool _isSetRetentionRequest;
     bool _isGetChainHeaderRequest;
     bool _isGetChainKeysRequest;
     bool _isGetChainInfoRequest;
+    bool _isListChainsRequest;
+    bool _isGetStatsRequest;
 
     int _chainId;
+    int _targetChainId;
     int _blockId;
+    int _durability;
+    int _engine;
+    bool _dedup;
+    int _retainBlocks;
+    int _retainAge;
+    int _startIndex;
+    int _startId;
+    int _maxCount;
+    int _maxBytes;
+    bool _reverse;
 
     std::string _password;
     std::string _data;
+    std::string _hash;
+    std::string _indices;
+    std::string _importPath;
+    std::string _backupPath;
+    std::string _uploadPath;
+    std::string _downloadPath;
 
     Network::Client* _client;
 };
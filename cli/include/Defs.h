@@ -24,4 +24,8 @@
 
 #ifndef PASSWORD_SALT
     #define PASSWORD_SALT "EMPTY_SALT/"
+#endif
+
+#ifndef MAX_CHUNK_LENGTH
+    #define MAX_CHUNK_LENGTH 65536
 #endif
\ No newline at end of file
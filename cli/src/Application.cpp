@@ -20,6 +20,9 @@
    SOFTWARE.
 */
 
+#include <fstream>
+#include <sstream>
+
 #include "Defs.h"
 #include "Application.h"
 
@@ -38,15 +41,35 @@ Application::Application() :
     _isPingRequest(false),
     _isCreateChainRequest(false),
     _isRemoveChainRequest(false),
+    _isBackupChainRequest(false),
+    _isCloneChainRequest(false),
     _isAddBlockRequest(false),
+    _isImportBlocksRequest(false),
     _isGetBlockRequest(false),
+    _isDownloadBlockRequest(false),
+    _isGetBlockByHashRequest(false),
     _isGetBlocksRequest(false),
+    _isGetBlocksByIndexRequest(false),
     _isVerifyChainRequest(false),
+    _isSetRetentionRequest(false),
     _isGetChainHeaderRequest(false),
     _isGetChainKeysRequest(false),
     _isGetChainInfoRequest(false),
+    _isListChainsRequest(false),
+    _isGetStatsRequest(false),
     _chainId(1),
+    _targetChainId(0),
     _blockId(1),
+    _durability(0),
+    _engine(0),
+    _dedup(false),
+    _retainBlocks(0),
+    _retainAge(0),
+    _startIndex(0),
+    _startId(0),
+    _maxCount(0),
+    _maxBytes(0),
+    _reverse(false),
     _data("{}")
 {
 }
@@ -64,17 +87,43 @@ bool Application::initialize(const int argc, const char* argv[])
         {"--ping", &_isPingRequest},
         {"--create-chain", &_isCreateChainRequest},
         {"--remove-chain", &_isRemoveChainRequest},
+        {"--backup-chain", &_isBackupChainRequest},
+        {"--clone-chain", &_isCloneChainRequest},
         {"--add-block", &_isAddBlockRequest},
+        {"--import-blocks", &_isImportBlocksRequest},
         {"--get-block", &_isGetBlockRequest},
+        {"--download-block", &_isDownloadBlockRequest},
+        {"--get-block-by-hash", &_isGetBlockByHashRequest},
         {"--get-blocks", &_isGetBlocksRequest},
+        {"--get-blocks-by-index", &_isGetBlocksByIndexRequest},
         {"--verify-chain", &_isVerifyChainRequest},
+        {"--set-retention", &_isSetRetentionRequest},
         {"--get-header", &_isGetChainHeaderRequest},
         {"--get-keys", &_isGetChainKeysRequest},
         {"--get-info", &_isGetChainInfoRequest},
+        {"--list-chains", &_isListChainsRequest},
+        {"--get-stats", &_isGetStatsRequest},
         {"--chain-id", &_chainId},
+        {"--target-chain-id", &_targetChainId},
         {"--block-id", &_blockId},
+        {"--durability", &_durability},
+        {"--engine", &_engine},
+        {"--dedup", &_dedup},
+        {"--retain-blocks", &_retainBlocks},
+        {"--retain-age", &_retainAge},
+        {"--start-index", &_startIndex},
+        {"--start-id", &_startId},
+        {"--max-count", &_maxCount},
+        {"--max-bytes", &_maxBytes},
+        {"--reverse", &_reverse},
         {"--password", &_password},
-        {"--data", &_data}
+        {"--data", &_data},
+        {"--hash", &_hash},
+        {"--indices", &_indices},
+        {"--import-path", &_importPath},
+        {"--backup-path", &_backupPath},
+        {"--upload-path", &_uploadPath},
+        {"--download-path", &_downloadPath}
     };
 
     if (!parseArgs(argc, argv, handlers))
@@ -103,22 +152,50 @@ bool Application::run()
     {
         return removeChain(_chainId);
     }
+    else if (_isBackupChainRequest)
+    {
+        return backupChain(_chainId, _backupPath);
+    }
+    else if (_isCloneChainRequest)
+    {
+        return cloneChain(_chainId, _targetChainId);
+    }
     else if (_isAddBlockRequest)
     {
-        return addBlock(_chainId, _data);
+        return _uploadPath.empty() ? addBlock(_chainId, _data) : addLargeBlock(_chainId, _data, _uploadPath);
+    }
+    else if (_isImportBlocksRequest)
+    {
+        return importBlocks(_chainId, _importPath);
     }
     else if (_isGetBlockRequest)
     {
         return getBlock(_chainId, _blockId);
     }
+    else if (_isDownloadBlockRequest)
+    {
+        return downloadBlock(_chainId, _blockId, _downloadPath);
+    }
+    else if (_isGetBlockByHashRequest)
+    {
+        return getBlockByHash(_chainId, _hash);
+    }
     else if (_isGetBlocksRequest)
     {
         return getBlocks(_chainId);
     }
+    else if (_isGetBlocksByIndexRequest)
+    {
+        return getBlocksByIndex(_chainId, _indices);
+    }
     else if (_isVerifyChainRequest)
     {
         return verifyChain(_chainId);
     }
+    else if (_isSetRetentionRequest)
+    {
+        return setRetention(_chainId, _retainBlocks, _retainAge);
+    }
     else if (_isGetChainHeaderRequest)
     {
         return getChainHeader(_chainId);
@@ -131,6 +208,14 @@ bool Application::run()
     {
         return getChainInfo(_chainId);
     }
+    else if (_isListChainsRequest)
+    {
+        return listChains(_startId);
+    }
+    else if (_isGetStatsRequest)
+    {
+        return getStats();
+    }
 
     return true;
 }
@@ -152,6 +237,9 @@ bool Application::createChain(const size_t chainId, const std::string& data) con
 
     req.mutable_create_chain_request()->set_chain_id(chainId);
     req.mutable_create_chain_request()->set_data(data);
+    req.mutable_create_chain_request()->set_durability(_durability);
+    req.mutable_create_chain_request()->set_engine(_engine);
+    req.mutable_create_chain_request()->set_dedup(_dedup);
 
     return processRequest(req);
 }
@@ -167,6 +255,30 @@ bool Application::removeChain(const size_t chainId) const
     return processRequest(req);
 }
 
+bool Application::backupChain(const size_t chainId, const std::string& path) const
+{
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_backup_chain_request()->set_chain_id(chainId);
+    req.mutable_backup_chain_request()->set_path(path);
+
+    return processRequest(req);
+}
+
+bool Application::cloneChain(const size_t chainId, const size_t targetChainId) const
+{
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_clone_chain_request()->set_chain_id(chainId);
+    req.mutable_clone_chain_request()->set_target_chain_id(targetChainId);
+
+    return processRequest(req);
+}
+
 bool Application::addBlock(const size_t chainId, const std::string& data) const
 {
     Service::IPC::Request req;
@@ -175,6 +287,121 @@ bool Application::addBlock(const size_t chainId, const std::string& data) const
 
     req.mutable_add_block_request()->set_chain_id(chainId);
     req.mutable_add_block_request()->set_data(data);
+    req.mutable_add_block_request()->set_durability(_durability);
+
+    return processRequest(req);
+}
+
+bool Application::addLargeBlock(const size_t chainId, const std::string& data, const std::string& path) const
+{
+    std::ifstream stream(path, std::ios::binary);
+
+    if (!stream)
+    {
+        Logger::error("Can\'t open file (Path: {})", path);
+        return false;
+    }
+
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_add_block_request()->set_chain_id(chainId);
+    req.mutable_add_block_request()->set_data(data);
+    req.mutable_add_block_request()->set_durability(_durability);
+
+    std::string chunk(MAX_CHUNK_LENGTH, '\0');
+
+    while (stream.read(chunk.data(), chunk.size()) || stream.gcount())
+    {
+        Service::IPC::Request chunkReq;
+        Service::IPC::Response chunkResp;
+
+        setAuthData(chunkReq.mutable_auth_data());
+
+        chunkReq.mutable_upload_chunk_request()->set_chain_id(chainId);
+        chunkReq.mutable_upload_chunk_request()->set_data(chunk.data(), stream.gcount());
+
+        if (!processRequest(chunkReq, chunkResp) || chunkResp.status().status())
+        {
+            Logger::error("Can\'t upload chunk");
+            return false;
+        }
+
+        req.mutable_add_block_request()->add_chunks(chunkResp.upload_chunk_response().hash());
+    }
+
+    return processRequest(req);
+}
+
+bool Application::downloadBlock(const size_t chainId, const size_t blockId, const std::string& path) const
+{
+    Service::IPC::Request req;
+    Service::IPC::Response resp;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_get_block_request()->set_chain_id(chainId);
+    req.mutable_get_block_request()->set_block_id(blockId);
+
+    if (!processRequest(req, resp) || resp.status().status())
+    {
+        Logger::error("Can\'t get block");
+        return false;
+    }
+
+    std::ofstream stream(path, std::ios::binary);
+
+    if (!stream)
+    {
+        Logger::error("Can\'t open file (Path: {})", path);
+        return false;
+    }
+
+    for (const std::string& hash : resp.get_block_response().block().chunks())
+    {
+        Service::IPC::Request chunkReq;
+        Service::IPC::Response chunkResp;
+
+        setAuthData(chunkReq.mutable_auth_data());
+
+        chunkReq.mutable_get_chunk_request()->set_chain_id(chainId);
+        chunkReq.mutable_get_chunk_request()->set_hash(hash);
+
+        if (!processRequest(chunkReq, chunkResp) || chunkResp.status().status())
+        {
+            Logger::error("Can\'t get chunk");
+            return false;
+        }
+
+        stream.write(chunkResp.get_chunk_response().data().data(), chunkResp.get_chunk_response().data().size());
+    }
+
+    return static_cast<bool>(stream);
+}
+
+bool Application::importBlocks(const size_t chainId, const std::string& path) const
+{
+    std::ifstream stream(path);
+
+    if (!stream)
+    {
+        Logger::error("Can\'t open file (Path: {})", path);
+        return false;
+    }
+
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_import_blocks_request()->set_chain_id(chainId);
+
+    std::string line;
+
+    while (std::getline(stream, line))
+    {
+        req.mutable_import_blocks_request()->add_data(line);
+    }
 
     return processRequest(req);
 }
@@ -191,6 +418,31 @@ bool Application::getBlock(const size_t chainId, const size_t blockId) const
     return processRequest(req);
 }
 
+bool Application::getBlockByHash(const size_t chainId, const std::string& hash) const
+{
+    if (hash.size() % 2 || hash.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+    {
+        Logger::error("Invalid hash ({})", hash);
+        return false;
+    }
+
+    std::string data;
+
+    for (size_t i = 0; i < hash.size(); i += 2)
+    {
+        data.push_back(static_cast<char>(std::stoi(hash.substr(i, 2), nullptr, 16)));
+    }
+
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_get_block_by_hash_request()->set_chain_id(chainId);
+    req.mutable_get_block_by_hash_request()->set_hash(data);
+
+    return processRequest(req);
+}
+
 bool Application::getBlocks(const size_t chainId) const
 {
     Service::IPC::Request req;
@@ -198,6 +450,40 @@ bool Application::getBlocks(const size_t chainId) const
     setAuthData(req.mutable_auth_data());
 
     req.mutable_get_blocks_request()->set_chain_id(chainId);
+    req.mutable_get_blocks_request()->set_start_index(_startIndex);
+    req.mutable_get_blocks_request()->set_max_count(_maxCount);
+    req.mutable_get_blocks_request()->set_max_bytes(_maxBytes);
+    req.mutable_get_blocks_request()->set_reverse(_reverse);
+
+    return processRequest(req);
+}
+
+bool Application::getBlocksByIndex(const size_t chainId, const std::string& indices) const
+{
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    std::stringstream stream(indices);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+    {
+        const size_t pos = item.find(':');
+
+        Service::IPC::BlockIndex* index = req.mutable_get_blocks_by_index_request()->add_items();
+
+        try
+        {
+            index->set_chain_id(pos == std::string::npos ? chainId : std::stoull(item.substr(0, pos)));
+            index->set_index(std::stoull(pos == std::string::npos ? item : item.substr(pos + 1)));
+        }
+        catch (const std::exception&)
+        {
+            Logger::error("Invalid index ({})", item);
+            return false;
+        }
+    }
 
     return processRequest(req);
 }
@@ -213,6 +499,19 @@ bool Application::verifyChain(const size_t chainId) const
     return processRequest(req);
 }
 
+bool Application::setRetention(const size_t chainId, const size_t retainBlocks, const uint64_t retainAge) const
+{
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_set_retention_request()->set_chain_id(chainId);
+    req.mutable_set_retention_request()->set_retain_blocks(retainBlocks);
+    req.mutable_set_retention_request()->set_retain_age(retainAge);
+
+    return processRequest(req);
+}
+
 bool Application::getChainHeader(const size_t chainId) const
 {
     Service::IPC::Request req;
@@ -246,6 +545,29 @@ bool Application::getChainInfo(const size_t chainId) const
     return processRequest(req);
 }
 
+bool Application::listChains(const size_t startId) const
+{
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_list_chains_request()->set_start_id(startId);
+    req.mutable_list_chains_request()->set_max_count(_maxCount);
+
+    return processRequest(req);
+}
+
+bool Application::getStats() const
+{
+    Service::IPC::Request req;
+
+    setAuthData(req.mutable_auth_data());
+
+    req.mutable_get_stats_request();
+
+    return processRequest(req);
+}
+
 void Application::setAuthData(Service::IPC::AuthData* data) const
 {
     if (_password.empty())
@@ -267,10 +589,15 @@ void Application::setAuthData(Service::IPC::AuthData* data) const
 
 bool Application::processRequest(const Service::IPC::Request& req) const
 {
-    const TrackTimeScope scope(__FUNCTION__);
-
     Service::IPC::Response resp;
 
+    return processRequest(req, resp);
+}
+
+bool Application::processRequest(const Service::IPC::Request& req, Service::IPC::Response& resp) const
+{
+    const TrackTimeScope scope(__FUNCTION__);
+
     std::string data;
     if (!req.SerializeToString(&data))
     {
@@ -23,11 +23,46 @@ set(LOG_NAME "chain_db")
 set(LOG_MAX_FILE_SIZE 20000000)
 set(LOG_MAX_FILE_COUNT 20)
 
-set(DB_VERSION 1)
+set(DB_VERSION 6)
+set(DB_MIN_VERSION 1)
 set(MAX_DATA_LENGTH 8192)
+set(MAX_CHUNK_LENGTH 65536)
+set(MAX_CHUNK_COUNT 4096)
+
+set(GET_BLOCKS_MAX_COUNT 1024)
+set(GET_BLOCKS_MAX_BYTES 4194304)
+set(LIST_CHAINS_MAX_COUNT 1024)
+
+set(IMPORT_BATCH_SIZE 4096)
+set(UPGRADE_BATCH_SIZE 1024)
 
 set(NONCE_LENGTH 8)
 
+set(CHAIN_CACHE_SIZE 256)
+set(CHAIN_CACHE_TIMEOUT 300)
+
+set(SYNC_INTERVAL 100)
+set(RECLAIM_INTERVAL 100)
+set(RECLAIM_RATE 67108864)
+set(PRUNE_INTERVAL 1000)
+set(PRUNE_BATCH_SIZE 1024)
+set(ARCHIVE_THRESHOLD 0)
+set(ARCHIVE_RANGE_SIZE 4096)
+set(ARCHIVE_FRAME_SIZE 65536)
+
+set(SCAN_READAHEAD 2097152)
+
+set(COMPRESSION 0)
+set(COMPRESSION_DICT_SIZE 16384)
+
+set(BLOCK_CACHE_SIZE 67108864)
+set(BLOOM_BITS_PER_KEY 10)
+set(WRITE_BUFFER_SIZE 4194304)
+set(MAX_OPEN_FILES 64)
+
+set(LOG_SEGMENT_SIZE 67108864)
+set(DEDUP_MIN_LENGTH 64)
+
 add_definitions(-DSERVICE_VERSION=${PROJECT_VERSION})
 
 add_definitions(-DLOG_NAME="${LOG_NAME}")
@@ -36,6 +71,41 @@ add_definitions(-DLOG_MAX_FILE_SIZE=${LOG_MAX_FILE_SIZE})
 add_definitions(-DLOG_MAX_FILE_COUNT=${LOG_MAX_FILE_COUNT})
 
 add_definitions(-DDB_VERSION=${DB_VERSION})
+add_definitions(-DDB_MIN_VERSION=${DB_MIN_VERSION})
 add_definitions(-DMAX_DATA_LENGTH=${MAX_DATA_LENGTH})
+add_definitions(-DMAX_CHUNK_LENGTH=${MAX_CHUNK_LENGTH})
+add_definitions(-DMAX_CHUNK_COUNT=${MAX_CHUNK_COUNT})
+
+add_definitions(-DGET_BLOCKS_MAX_COUNT=${GET_BLOCKS_MAX_COUNT})
+add_definitions(-DGET_BLOCKS_MAX_BYTES=${GET_BLOCKS_MAX_BYTES})
+add_definitions(-DLIST_CHAINS_MAX_COUNT=${LIST_CHAINS_MAX_COUNT})
+
+add_definitions(-DIMPORT_BATCH_SIZE=${IMPORT_BATCH_SIZE})
+add_definitions(-DUPGRADE_BATCH_SIZE=${UPGRADE_BATCH_SIZE})
+
+add_definitions(-DNONCE_LENGTH=${NONCE_LENGTH})
+
+add_definitions(-DCHAIN_CACHE_SIZE=${CHAIN_CACHE_SIZE})
+add_definitions(-DCHAIN_CACHE_TIMEOUT=${CHAIN_CACHE_TIMEOUT})
+
+add_definitions(-DSYNC_INTERVAL=${SYNC_INTERVAL})
+add_definitions(-DRECLAIM_INTERVAL=${RECLAIM_INTERVAL})
+add_definitions(-DRECLAIM_RATE=${RECLAIM_RATE})
+add_definitions(-DPRUNE_INTERVAL=${PRUNE_INTERVAL})
+add_definitions(-DPRUNE_BATCH_SIZE=${PRUNE_BATCH_SIZE})
+add_definitions(-DARCHIVE_THRESHOLD=${ARCHIVE_THRESHOLD})
+add_definitions(-DARCHIVE_RANGE_SIZE=${ARCHIVE_RANGE_SIZE})
+add_definitions(-DARCHIVE_FRAME_SIZE=${ARCHIVE_FRAME_SIZE})
+
+add_definitions(-DSCAN_READAHEAD=${SCAN_READAHEAD})
+
+add_definitions(-DCOMPRESSION=${COMPRESSION})
+add_definitions(-DCOMPRESSION_DICT_SIZE=${COMPRESSION_DICT_SIZE})
+
+add_definitions(-DBLOCK_CACHE_SIZE=${BLOCK_CACHE_SIZE})
+add_definitions(-DBLOOM_BITS_PER_KEY=${BLOOM_BITS_PER_KEY})
+add_definitions(-DWRITE_BUFFER_SIZE=${WRITE_BUFFER_SIZE})
+add_definitions(-DMAX_OPEN_FILES=${MAX_OPEN_FILES})
 
-add_definitions(-DNONCE_LENGTH=${NONCE_LENGTH})
\ No newline at end of file
+add_definitions(-DLOG_SEGMENT_SIZE=${LOG_SEGMENT_SIZE})
+add_definitions(-DDEDUP_MIN_LENGTH=${DEDUP_MIN_LENGTH})
\ No newline at end of file
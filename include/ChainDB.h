@@ -25,6 +25,7 @@
 #include "System/Logger.h"
 #include "System/IService.h"
 #include "Network/Server/Server.h"
+#include "Storage/Manager.h"
 
 namespace Core
 {
@@ -49,17 +50,43 @@ private:
     void initializeLogger() const;
     bool initializeRandomGenerator() const;
 
+    bool importChain(const Storage::Manager& manager) const;
+
     static void signalHandler(int signum);
 
 private:
     bool _daemonize;
+    bool _upgrade;
 
     std::string _logPath;
     std::string _storageDir;
+    std::string _backupDir;
+    std::string _storageLayout;
+    std::string _storageBackend;
     std::string _password;
+    std::string _importPath;
+
+    int _importChainId;
 
     int _serverPort;
 
+    int _cacheSize;
+    int _cacheTimeout;
+
+    int _syncInterval;
+    int _reclaimInterval;
+    int _reclaimRate;
+    int _pruneInterval;
+    int _archiveThreshold;
+
+    std::string _compression;
+    int _compressionDictSize;
+
+    int _blockCacheSize;
+    int _bloomBitsPerKey;
+    int _writeBufferSize;
+    int _maxOpenFiles;
+
     Network::Server* _server;
 };
 
@@ -42,14 +42,122 @@
     #define DB_VERSION 0
 #endif
 
+#ifndef DB_MIN_VERSION
+    #define DB_MIN_VERSION 0
+#endif
+
 #ifndef MAX_DATA_LENGTH
     #define MAX_DATA_LENGTH 8192
 #endif
 
+#ifndef MAX_CHUNK_LENGTH
+    #define MAX_CHUNK_LENGTH 65536
+#endif
+
+#ifndef MAX_CHUNK_COUNT
+    #define MAX_CHUNK_COUNT 4096
+#endif
+
+#ifndef GET_BLOCKS_MAX_COUNT
+    #define GET_BLOCKS_MAX_COUNT 1024
+#endif
+
+#ifndef GET_BLOCKS_MAX_BYTES
+    #define GET_BLOCKS_MAX_BYTES 4194304
+#endif
+
+#ifndef LIST_CHAINS_MAX_COUNT
+    #define LIST_CHAINS_MAX_COUNT 1024
+#endif
+
+#ifndef IMPORT_BATCH_SIZE
+    #define IMPORT_BATCH_SIZE 4096
+#endif
+
+#ifndef UPGRADE_BATCH_SIZE
+    #define UPGRADE_BATCH_SIZE 1024
+#endif
+
 #ifndef NONCE_LENGTH
     #define NONCE_LENGTH 8
 #endif
 
+#ifndef CHAIN_CACHE_SIZE
+    #define CHAIN_CACHE_SIZE 256
+#endif
+
+#ifndef CHAIN_CACHE_TIMEOUT
+    #define CHAIN_CACHE_TIMEOUT 300
+#endif
+
+#ifndef SYNC_INTERVAL
+    #define SYNC_INTERVAL 100
+#endif
+
+#ifndef RECLAIM_INTERVAL
+    #define RECLAIM_INTERVAL 100
+#endif
+
+#ifndef RECLAIM_RATE
+    #define RECLAIM_RATE 67108864
+#endif
+
+#ifndef PRUNE_INTERVAL
+    #define PRUNE_INTERVAL 1000
+#endif
+
+#ifndef PRUNE_BATCH_SIZE
+    #define PRUNE_BATCH_SIZE 1024
+#endif
+
+#ifndef ARCHIVE_THRESHOLD
+    #define ARCHIVE_THRESHOLD 0
+#endif
+
+#ifndef ARCHIVE_RANGE_SIZE
+    #define ARCHIVE_RANGE_SIZE 4096
+#endif
+
+#ifndef ARCHIVE_FRAME_SIZE
+    #define ARCHIVE_FRAME_SIZE 65536
+#endif
+
+#ifndef SCAN_READAHEAD
+    #define SCAN_READAHEAD 2097152
+#endif
+
+#ifndef COMPRESSION
+    #define COMPRESSION 0
+#endif
+
+#ifndef COMPRESSION_DICT_SIZE
+    #define COMPRESSION_DICT_SIZE 16384
+#endif
+
+#ifndef BLOCK_CACHE_SIZE
+    #define BLOCK_CACHE_SIZE 67108864
+#endif
+
+#ifndef BLOOM_BITS_PER_KEY
+    #define BLOOM_BITS_PER_KEY 10
+#endif
+
+#ifndef WRITE_BUFFER_SIZE
+    #define WRITE_BUFFER_SIZE 4194304
+#endif
+
+#ifndef MAX_OPEN_FILES
+    #define MAX_OPEN_FILES 64
+#endif
+
+#ifndef LOG_SEGMENT_SIZE
+    #define LOG_SEGMENT_SIZE 67108864
+#endif
+
+#ifndef DEDUP_MIN_LENGTH
+    #define DEDUP_MIN_LENGTH 64
+#endif
+
 #ifndef PASSWORD_SALT
     #define PASSWORD_SALT "EMPTY_SALT/"
 #endif
\ No newline at end of file
@@ -51,13 +51,23 @@ private:
     Network::Message::Ptr handlePingRequest(const Service::IPC::PingRequest&) const;
     Network::Message::Ptr handleCreateChainRequest(const Service::IPC::CreateChainRequest& req) const;
     Network::Message::Ptr handleRemoveChainRequest(const Service::IPC::RemoveChainRequest& req) const;
+    Network::Message::Ptr handleBackupChainRequest(const Service::IPC::BackupChainRequest& req) const;
+    Network::Message::Ptr handleCloneChainRequest(const Service::IPC::CloneChainRequest& req) const;
     Network::Message::Ptr handleAddBlockRequest(const Service::IPC::AddBlockRequest& req) const;
+    Network::Message::Ptr handleImportBlocksRequest(const Service::IPC::ImportBlocksRequest& req) const;
+    Network::Message::Ptr handleUploadChunkRequest(const Service::IPC::UploadChunkRequest& req) const;
+    Network::Message::Ptr handleGetChunkRequest(const Service::IPC::GetChunkRequest& req) const;
     Network::Message::Ptr handleGetBlockRequest(const Service::IPC::GetBlockRequest& req) const;
+    Network::Message::Ptr handleGetBlockByHashRequest(const Service::IPC::GetBlockByHashRequest& req) const;
     Network::Message::Ptr handleGetBlocksRequest(const Service::IPC::GetBlocksRequest& req) const;
+    Network::Message::Ptr handleGetBlocksByIndexRequest(const Service::IPC::GetBlocksByIndexRequest& req) const;
     Network::Message::Ptr handleVerifyChainRequest(const Service::IPC::VerifyChainRequest& req) const;
+    Network::Message::Ptr handleSetRetentionRequest(const Service::IPC::SetRetentionRequest& req) const;
     Network::Message::Ptr handleGetChainHeaderRequest(const Service::IPC::GetChainHeaderRequest& req) const;
     Network::Message::Ptr handleGetChainKeysRequest(const Service::IPC::GetChainKeysRequest& req) const;
     Network::Message::Ptr handleGetChainInfoRequest(const Service::IPC::GetChainInfoRequest& req) const;
+    Network::Message::Ptr handleListChainsRequest(const Service::IPC::ListChainsRequest& req) const;
+    Network::Message::Ptr handleGetStatsRequest(const Service::IPC::GetStatsRequest&) const;
 
     Network::Message::Ptr makeResponse(const Service::IPC::Response& resp) const;
     Network::Message::Ptr makeStatus(const Status status, const std::string& text = "") const;
@@ -67,6 +77,8 @@ private:
 
     void setBlockData(Service::Blockchain::Block* data, const Storage::Block::Ptr block) const;
 
+    Crypto::SHA256::Hash::Ptr makeHash(const std::string& data) const;
+
 private:
     Storage::Manager& _manager;
     std::string _password;
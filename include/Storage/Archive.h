@@ -0,0 +1,127 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "Defs.h"
+
+namespace Core::Storage
+{
+
+class Archive
+{
+public:
+    typedef std::shared_ptr<Archive> Ptr;
+    typedef std::string Data;
+    typedef std::vector<Data> DataList;
+
+    explicit Archive(const std::string& path, const size_t frameSize = ARCHIVE_FRAME_SIZE);
+    ~Archive();
+
+    Archive(Archive const&) = delete;
+    void operator=(Archive const&) = delete;
+
+    bool open();
+    bool close();
+
+    bool isOpen() const;
+
+    bool append(const size_t first, const DataList& records);
+
+    bool prepare(const size_t first, const DataList& records, std::string& tmpPath) const;
+    bool publish(const size_t first, const std::string& tmpPath);
+    bool get(const size_t index, Data& data) const;
+
+    bool truncate(const size_t count);
+
+    bool remove() const;
+
+    bool checkpoint(const std::string& path) const;
+
+    size_t size() const;
+    uint64_t getDataSize() const;
+    uint64_t getStorageSize() const;
+
+private:
+    struct Frame
+    {
+        size_t first;
+        uint64_t offset;
+        uint32_t length;
+        uint32_t rawLength;
+    };
+
+    struct File
+    {
+        typedef std::shared_ptr<File> Ptr;
+
+        File(const std::string& path, const size_t first);
+        ~File();
+
+        std::string path;
+        size_t first;
+        size_t count;
+        uint64_t length;
+        uint64_t dataSize;
+        std::vector<Frame> frames;
+
+        const char* map;
+        size_t mapLength;
+    };
+
+    File::Ptr load(const std::string& path) const;
+    bool map(const File::Ptr file) const;
+    bool decode(const File::Ptr file, const size_t frame) const;
+
+    bool read(const int fd, const uint64_t offset, char* data, const size_t length) const;
+    bool write(const int fd, const uint64_t offset, const char* data, const size_t length) const;
+
+    bool syncDirectory() const;
+
+    File::Ptr find(const size_t index) const;
+    size_t getCount() const;
+
+    std::string makeFilePath(const size_t first) const;
+
+private:
+    std::string _path;
+    size_t _frameSize;
+
+    std::vector<File::Ptr> _files;
+    bool _isOpen;
+
+    mutable File::Ptr _cacheFile;
+    mutable size_t _cacheFrame;
+    mutable Data _cacheData;
+
+    mutable std::mutex _mutex;
+};
+
+}
+
@@ -22,7 +22,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #include "Defs.h"
 #include "Crypto/Data.h"
@@ -43,12 +46,17 @@ public:
             typedef std::shared_ptr<Container> Ptr;
             typedef Crypto::Data<NONCE_LENGTH> Nonce;
             typedef std::string Data;
+            typedef std::vector<Crypto::SHA256::Hash::Ptr> ChunkList;
 
             Container(const Crypto::SHA256::Hash::Ptr hash,
                 const Crypto::SHA256::Hash::Ptr prevHash,
                 const Nonce::Ptr nonce,
                 const Data& data,
-                const Crypto::Secp256k1::Signature::Ptr signature);
+                const Crypto::Secp256k1::Signature::Ptr signature,
+                const ChunkList& chunks = ChunkList(),
+                const Crypto::SHA256::Hash::Ptr payloadHash = nullptr,
+                const uint64_t timestamp = 0,
+                const bool pruned = false);
             ~Container();
 
             Crypto::SHA256::Hash::Ptr getHash() const;
@@ -59,8 +67,21 @@ public:
 
             Crypto::Secp256k1::Signature::Ptr getSignature() const;
 
+            ChunkList getChunks() const;
+
+            Crypto::SHA256::Hash::Ptr getPayloadHash() const;
+
+            uint64_t getTimestamp() const;
+
+            bool isPruned() const;
+
+            static Data encodeChunks(const ChunkList& chunks);
+
             static bool pack(const Block::Container::Ptr container, Data& outbuf);
-            static Block::Container::Ptr unpack(const Data& inbuf);
+            static Block::Container::Ptr unpack(const std::string_view inbuf);
+
+            static bool packMessage(const Block::Container::Ptr container, Data& outbuf);
+            static Block::Container::Ptr unpackMessage(const std::string_view inbuf);
 
         private:
             Crypto::SHA256::Hash::Ptr _hash;
@@ -68,6 +89,10 @@ public:
             Nonce::Ptr _nonce;
             Data _data;
             Crypto::Secp256k1::Signature::Ptr _signature;
+            ChunkList _chunks;
+            Crypto::SHA256::Hash::Ptr _payloadHash;
+            uint64_t _timestamp;
+            bool _pruned;
     };
 
     explicit Block(const Container::Ptr data);
@@ -0,0 +1,96 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Storage/Chain.h"
+
+namespace Core::Storage
+{
+
+class Cache
+{
+public:
+    typedef std::function<Chain::Ptr()> Loader;
+
+    typedef std::vector<std::pair<size_t, Chain::Ptr>> ChainList;
+    typedef std::function<void(const ChainList&)> Evictor;
+
+    Cache(const size_t capacity, const size_t idleTimeout, const Evictor& evictor = nullptr);
+    ~Cache();
+
+    Cache(Cache const&) = delete;
+    void operator=(Cache const&) = delete;
+
+    Chain::Ptr get(const size_t chainId, const Loader& loader);
+    Chain::Ptr find(const size_t chainId) const;
+
+    void remove(const size_t chainId);
+    void clear();
+
+    bool isInUse(const size_t chainId);
+
+    size_t size() const;
+
+    void forEach(const std::function<void(const Chain::Ptr&)>& callback) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Entry
+    {
+        size_t chainId;
+        Chain::Ptr chain;
+        Clock::time_point lastAccess;
+    };
+
+    typedef std::list<Entry> EntryList;
+
+    void evict(ChainList& chains);
+    void release(std::unique_lock<std::mutex>& lock, ChainList& chains);
+
+private:
+    size_t _capacity;
+    std::chrono::seconds _idleTimeout;
+    Evictor _evictor;
+
+    EntryList _entries;
+    std::unordered_map<size_t, EntryList::iterator> _index;
+    std::unordered_set<size_t> _loading;
+    std::unordered_map<size_t, std::weak_ptr<Chain>> _removed;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+};
+
+}
@@ -0,0 +1,97 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Storage/Storage.h"
+
+namespace Core::Storage
+{
+
+class Catalog
+{
+public:
+    typedef std::shared_ptr<Catalog> Ptr;
+
+    struct Entry
+    {
+        size_t chainId;
+        uint32_t layout;
+        uint64_t createdAt;
+        size_t index;
+        uint64_t dataSize;
+    };
+
+    typedef std::vector<Entry> EntryList;
+
+    explicit Catalog(const std::string& path, const Storage::Options& options = Storage::Options());
+    ~Catalog();
+
+    Catalog(Catalog const&) = delete;
+    void operator=(Catalog const&) = delete;
+
+    bool create();
+    bool open();
+
+    bool exists() const;
+
+    bool addChain(const Entry& entry) const;
+    bool removeChain(const size_t chainId) const;
+
+    bool updateChains(const EntryList& entries, const Storage::Durability durability = Storage::ASYNC) const;
+
+    bool hasChain(const size_t chainId) const;
+
+    bool hasTombstone(const size_t chainId) const;
+    bool removeTombstone(const size_t chainId) const;
+
+    bool getTombstones(std::vector<size_t>& chainIds) const;
+
+    bool getChain(const size_t chainId, Entry& entry) const;
+
+    bool getChains(const size_t startId,
+        const size_t maxCount,
+        EntryList& entries,
+        size_t& nextId) const;
+
+private:
+    bool getChain(const std::string& name, Entry& entry, bool& isFound) const;
+
+    std::string makeEntryName(const size_t chainId) const;
+    std::string makeTombstoneName(const size_t chainId) const;
+
+    static bool pack(const Entry& entry, std::string& outbuf);
+    static bool unpack(const std::string_view inbuf, Entry& entry);
+
+private:
+    Storage _storage;
+
+    mutable std::mutex _mutex;
+};
+
+}
@@ -23,11 +23,17 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
 #include <memory>
+#include <mutex>
 
 #include "Crypto/ECDSA.h"
+#include "Crypto/SHA256.h"
 #include "Storage/Storage.h"
+#include "Storage/Log.h"
+#include "Storage/Archive.h"
 #include "Storage/Block.h"
 
 namespace Core::Storage
@@ -37,6 +43,13 @@ class Chain
 {
 public:
     typedef std::shared_ptr<Chain> Ptr;
+    typedef std::function<Block::Ptr(const Crypto::SHA256::Hash::Ptr prevHash)> BlockBuilder;
+
+    enum Engine
+    {
+        STORAGE = 0,
+        LOG = 1
+    };
 
     struct Header
     {
@@ -63,46 +76,209 @@ public:
 
             void setIndex(size_t index);
 
+            Storage::Durability getDurability() const;
+
+            void setDurability(const Storage::Durability durability);
+
+            Engine getEngine() const;
+
+            void setEngine(const Engine engine);
+
+            bool isDedup() const;
+
+            void setDedup(const bool dedup);
+
+            size_t getRetainBlocks() const;
+
+            void setRetainBlocks(const size_t retainBlocks);
+
+            uint64_t getRetainAge() const;
+
+            void setRetainAge(const uint64_t retainAge);
+
             Data getData() const;
 
             Crypto::Secp256k1::PrivateKey::Ptr getPrivateKey() const;
             Crypto::Secp256k1::PublicKey::Ptr getPublicKey() const;
 
             static bool pack(const Chain::Header::Ptr header, Data& outbuf);
-            static Chain::Header::Ptr unpack(const Data& inbuf);
+            static Chain::Header::Ptr unpack(const std::string_view inbuf);
 
         private:
             size_t _version;
             size_t _index;
+            Storage::Durability _durability;
+            Engine _engine;
+            bool _dedup;
+            size_t _retainBlocks;
+            uint64_t _retainAge;
             Data _data;
             Crypto::Secp256k1::PrivateKey::Ptr _privateKey;
             Crypto::Secp256k1::PublicKey::Ptr _publicKey;
     };
 
-    explicit Chain(const std::string& path);
+    explicit Chain(const std::string& path, const Storage::Options& options = Storage::Options());
+    Chain(const Storage::Ptr& database, const std::string& prefix, const std::string& logPath);
     ~Chain();
 
+    Chain(Chain const&) = delete;
+    void operator=(Chain const&) = delete;
+
+    bool open();
+    bool close();
+
+    bool isOpen() const;
+
     bool create(const Chain::Header::Data& data,
         Crypto::Secp256k1::PrivateKey::Ptr privateKey,
-        Crypto::Secp256k1::PublicKey::Ptr publicKey) const;
+        Crypto::Secp256k1::PublicKey::Ptr publicKey,
+        const Storage::Durability durability = Storage::SYNC,
+        const Engine engine = STORAGE,
+        const bool dedup = false) const;
 
-    bool addBlock(const Block::Ptr block) const;
+    bool addBlock(const Block::Ptr block, const Storage::Durability durability = Storage::SYNC) const;
+    Block::Ptr addBlock(const BlockBuilder& builder, const Storage::Durability durability = Storage::SYNC) const;
+    bool importBlocks(const std::vector<Block::Ptr>& blocks) const;
+
+    Crypto::SHA256::Hash::Ptr addChunk(const std::string& data, const Storage::Durability durability = Storage::SYNC) const;
+    bool getChunk(const Crypto::SHA256::Hash::Ptr hash, std::string& data) const;
+    bool hasChunks(const Block::Container::ChunkList& chunks) const;
 
     Block::Ptr getBlock(const size_t index) const;
+    Block::Ptr getBlockByHash(const std::string& hash) const;
 
     bool getBlocks(std::vector<Block::Ptr>& blocks) const;
 
+    bool getBlocks(const size_t startIndex,
+        const size_t maxCount,
+        const size_t maxBytes,
+        const bool reverse,
+        std::vector<Block::Ptr>& blocks,
+        size_t& nextIndex) const;
+
+    bool getBlocks(const std::vector<size_t>& indices, std::vector<Block::Ptr>& blocks) const;
+
     bool remove() const;
 
+    bool reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const;
+
+    bool clone(const Chain& target) const;
+
+    bool setRetention(const size_t retainBlocks, const uint64_t retainAge) const;
+
+    bool prune(const uint64_t now, size_t& count) const;
+
+    bool archive(const size_t threshold, size_t& count) const;
+
+    bool sync() const;
+
     Header::Ptr getHeader() const;
 
+    Crypto::SHA256::Hash::Ptr getTipHash() const;
+
+    bool getSize(uint64_t& dataSize, uint64_t& storageSize) const;
+
+    bool getDataSize(uint64_t& size) const;
+
+    bool getDedupSize(uint64_t& payloadSize, uint64_t& storedSize) const;
+
+    bool getPrunedIndex(size_t& index) const;
+
+    bool getArchiveInfo(size_t& index, uint64_t& size) const;
+
 private:
+    typedef std::map<std::string, uint64_t> Refs;
+
+    struct Payloads
+    {
+        Refs refs;
+        uint64_t dataSize;
+        uint64_t storedSize;
+    };
+
     Chain::Header::Ptr getHeader(const Storage& storage) const;
+    bool addBlock(const Storage& storage, const Block::Ptr block, const Storage::Durability durability) const;
+    Block::Ptr getBlock(const Storage& storage, const size_t index) const;
+
+    bool getIndex(const Storage& storage, size_t& index) const;
+    bool getDataSize(const Storage& storage, uint64_t& size) const;
+    Crypto::SHA256::Hash::Ptr getTipHash(const Storage& storage) const;
+    bool getPrunedIndex(const Storage& storage, size_t& index) const;
+    bool getArchivedIndex(const Storage& storage, size_t& index) const;
+
+    bool getPayloads(const Storage& storage, Payloads& payloads) const;
+    bool getRefs(const Storage& storage, const std::string& name, Refs& refs, Refs::iterator& it) const;
+    bool addPayload(const Storage& storage,
+        Block::Container::Ptr& container,
+        Payloads& payloads,
+        Storage::KeyValueList& pairs) const;
+    bool releasePayload(const Storage& storage,
+        const Crypto::SHA256::Hash::Ptr hash,
+        Payloads& payloads,
+        Storage::KeyList& keys,
+        Storage::Slice& payload) const;
+    void putPayloads(const Payloads& payloads, Storage::KeyValueList& pairs) const;
+
+    bool hasChunks(const Storage& storage, const Block::Container::ChunkList& chunks) const;
+    bool addChunkRefs(const Storage& storage, const Block::Container::ChunkList& chunks, Refs& refs) const;
+    bool releaseChunks(const Storage& storage,
+        const Block::Container::ChunkList& chunks,
+        Refs& refs,
+        Storage::KeyList& keys) const;
+    void putChunkRefs(const Refs& refs, Storage::KeyValueList& pairs) const;
+
+    void discardPairs(const Storage& storage, const Storage::KeyValueList& pairs) const;
+
+    bool pruneBlocks(const Storage& storage, const uint64_t now, const size_t maxCount, size_t& count) const;
+    bool archiveBlocks(const Storage& storage, const size_t threshold, size_t& count) const;
+
+    Block::Container::Ptr unpackBlock(const Storage& storage, const size_t index, const std::string_view value) const;
+
+    bool openLog(const Storage& storage, Log::Ptr& log) const;
+    bool recoverLog(const Storage& storage, const Log::Ptr log) const;
+
+    bool openArchive(const Storage& storage, Archive::Ptr& archive) const;
+    bool recoverArchive(const Storage& storage, const Archive::Ptr archive) const;
+
+    bool upgrade(const Storage& storage) const;
+    bool upgradeIndex(const Storage& storage, const Chain::Header::Ptr header) const;
+    bool upgradeBlockKeys(const Storage& storage, const Chain::Header::Ptr header) const;
+    bool upgradeDataSize(const Storage& storage, const Chain::Header::Ptr header) const;
+    bool upgradeHashIndex(const Storage& storage, const Chain::Header::Ptr header) const;
+    bool upgradeTipHash(const Storage& storage, const Chain::Header::Ptr header) const;
+
+    Storage::Ptr openStorage() const;
+    Storage::Ptr makeStorage() const;
 
     std::string makeBlockName(const size_t index) const;
+    bool parseBlockName(const std::string& name, size_t& index) const;
+    std::string makeHashName(const Block::Container::Ptr container) const;
+    std::string makeChunkName(const Crypto::SHA256::Hash::Ptr hash) const;
+    std::string makePayloadName(const Crypto::SHA256::Hash::Ptr hash) const;
+    std::string makeRefsName(const Crypto::SHA256::Hash::Ptr hash) const;
+    std::string makeChunkRefsName(const Crypto::SHA256::Hash::Ptr hash) const;
+
+    Crypto::SHA256::Hash::Ptr makeGenesisHash(const Chain::Header::Ptr header) const;
+
+    static std::string encodeHash(const Crypto::SHA256::Hash::Ptr hash);
+    static Crypto::SHA256::Hash::Ptr decodeHash(const std::string_view data);
 
 private:
     std::string _path;
+    std::string _logPath;
+    std::string _archivePath;
+    Storage::Options _options;
+    Storage::Ptr _database;
+    Storage::Ptr _storage;
+    Log::Ptr _log;
+    Archive::Ptr _archive;
+
+    mutable std::mutex _archiveMutex;
+
+    mutable std::mutex _mutex;
+    Chain::Header::Ptr _header;
+    mutable uint64_t _dataSize;
+    mutable Crypto::SHA256::Hash::Ptr _tipHash;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+#pragma once
+
+#include <string>
+
+#include "Storage/Storage.h"
+
+#ifdef USE_ROCKSDB
+    #include <rocksdb/db.h>
+    #include <rocksdb/write_batch.h>
+    #include <rocksdb/table.h>
+    #include <rocksdb/sst_file_writer.h>
+    #include <rocksdb/utilities/checkpoint.h>
+#else
+    #include <leveldb/db.h>
+    #include <leveldb/write_batch.h>
+#endif
+
+namespace Core::Storage
+{
+
+class DiskBackend : public Storage::Backend
+{
+public:
+    class Cursor : public Storage::Backend::Cursor
+    {
+    public:
+        explicit Cursor(DB::Iterator* it);
+        ~Cursor() override;
+
+        void seek(const std::string_view key) override;
+        void next() override;
+        void prev() override;
+
+        bool isValid() const override;
+        bool getStatus() const override;
+
+        std::string_view getKey() const override;
+        std::string_view getValue() const override;
+
+    private:
+        std::unique_ptr<DB::Iterator> _it;
+    };
+
+    DiskBackend(const std::string& path, const Storage::Options& options);
+    ~DiskBackend() override;
+
+    DiskBackend(DiskBackend const&) = delete;
+    void operator=(DiskBackend const&) = delete;
+
+    bool create() override;
+    bool open() override;
+    bool close() override;
+
+    bool exists() const override;
+
+    using Storage::Backend::get;
+
+    bool get(const Storage::KeyValue::Data& key, Storage::Slice& value, bool& isFound) const override;
+    bool multiGet(const Storage::KeyList& keys,
+        std::vector<Storage::Slice>& values,
+        Storage::StatusList& statuses) const override;
+    Storage::Backend::Cursor::Ptr scan(const Storage::ReadOptions& options) const override;
+    bool write(const Storage::KeyValueList& pairs, const Storage::KeyList& keys, const bool sync) const override;
+    bool ingest(const Storage::KeyValueList& pairs) const override;
+    bool checkpoint(const std::string& path) const override;
+    bool reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const override;
+    bool compact(const Storage::KeyValue::Data& start, const Storage::KeyValue::Data& limit) const override;
+
+    bool sync() const override;
+
+    bool getApproximateSize(const Storage::KeyValue::Data& start,
+        const Storage::KeyValue::Data& limit,
+        uint64_t& size) const override;
+
+    bool remove() const override;
+
+private:
+    DB::Options makeOptions() const;
+
+private:
+    std::string _path;
+    Storage::Options _options;
+    DB::DB* _db;
+};
+
+}
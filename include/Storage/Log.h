@@ -0,0 +1,130 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "Defs.h"
+
+namespace Core::Storage
+{
+
+class Log
+{
+public:
+    typedef std::shared_ptr<Log> Ptr;
+    typedef std::string Data;
+    typedef std::vector<Data> DataList;
+
+    explicit Log(const std::string& path, const size_t segmentSize = LOG_SEGMENT_SIZE);
+    ~Log();
+
+    Log(Log const&) = delete;
+    void operator=(Log const&) = delete;
+
+    bool create();
+
+    bool open();
+    bool close();
+
+    bool isOpen() const;
+
+    bool append(const DataList& records, const bool sync);
+    bool get(const size_t index, Data& data) const;
+
+    bool truncate(const size_t count);
+
+    bool sync();
+
+    bool remove() const;
+
+    bool checkpoint(const std::string& path) const;
+
+    size_t size() const;
+    uint64_t getDataSize() const;
+    uint64_t getStorageSize() const;
+
+private:
+    struct Segment
+    {
+        typedef std::shared_ptr<Segment> Ptr;
+
+        Segment(const std::string& path, const size_t first);
+        ~Segment();
+
+        std::string getDataPath() const;
+        std::string getIndexPath() const;
+        std::string getSealPath() const;
+
+        std::string path;
+        size_t first;
+        std::vector<uint64_t> offsets;
+        uint64_t length;
+
+        bool sealed;
+        bool verified;
+        uint32_t checksum;
+
+        int dataFd;
+        int indexFd;
+
+        const char* map;
+        size_t mapLength;
+    };
+
+    Segment::Ptr load(const size_t first) const;
+    Segment::Ptr make(const size_t first) const;
+
+    bool recover(const Segment::Ptr segment) const;
+    bool seal(const Segment::Ptr segment) const;
+    bool activate(const Segment::Ptr segment) const;
+
+    bool map(const Segment::Ptr segment, const uint64_t length) const;
+    void unmap(const Segment::Ptr segment) const;
+
+    bool write(const int fd, const uint64_t offset, const char* data, const size_t length) const;
+    bool readFile(const std::string& path, std::string& data) const;
+    bool copyFile(const std::string& from, const std::string& to, const uint64_t length) const;
+    bool detach(const Segment::Ptr segment) const;
+
+    Segment::Ptr find(const size_t index) const;
+    size_t getCount() const;
+
+    std::string makeSegmentPath(const size_t first) const;
+
+private:
+    std::string _path;
+    size_t _segmentSize;
+
+    std::vector<Segment::Ptr> _segments;
+    bool _isOpen;
+    bool _dirty;
+
+    mutable std::mutex _mutex;
+};
+
+}
@@ -22,10 +22,17 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include "Defs.h"
 #include "Crypto/ECDSA.h"
+#include "Storage/Cache.h"
+#include "Storage/Catalog.h"
+#include "Storage/Syncer.h"
+#include "Storage/Pruner.h"
+#include "Storage/Reclaimer.h"
 #include "Storage/Chain.h"
 #include "Storage/Block.h"
 
@@ -37,31 +44,136 @@ class Manager
 public:
     typedef std::vector<Block::Ptr> BlockList;
 
-    Manager(const std::string& storageDir);
+    struct BlockIndex
+    {
+        size_t chainId;
+        size_t index;
+    };
+
+    typedef std::vector<BlockIndex> BlockIndexList;
+
+    enum Layout
+    {
+        SEPARATE = 0,
+        SHARED = 1
+    };
+
+    struct ChainInfo
+    {
+        size_t version;
+        size_t index;
+        Storage::Durability durability;
+        Chain::Engine engine;
+        uint64_t dataSize;
+        uint64_t storageSize;
+        bool dedup;
+        uint64_t payloadSize;
+        uint64_t storedPayloadSize;
+        size_t retainBlocks;
+        uint64_t retainAge;
+        size_t prunedIndex;
+        size_t archivedIndex;
+        uint64_t archiveSize;
+    };
+
+    Manager(const std::string& storageDir,
+        const size_t cacheSize = CHAIN_CACHE_SIZE,
+        const size_t cacheTimeout = CHAIN_CACHE_TIMEOUT,
+        const Storage::Options& options = Storage::Options(),
+        const Layout layout = SEPARATE);
     ~Manager();
 
-    Chain::Ptr createChain(const size_t chainId, const std::string& data) const;
+    Chain::Ptr createChain(const size_t chainId,
+        const std::string& data,
+        const Storage::Durability durability = Storage::SYNC,
+        const Chain::Engine engine = Chain::STORAGE,
+        const bool dedup = false) const;
 
-    Block::Ptr addBlock(const size_t chainId, const std::string& data) const;
+    Block::Ptr addBlock(const size_t chainId,
+        const std::string& data,
+        const Storage::Durability durability = Storage::DEFAULT,
+        const Block::Container::ChunkList& chunks = Block::Container::ChunkList()) const;
+
+    Crypto::SHA256::Hash::Ptr addChunk(const size_t chainId, const std::string& data) const;
+    bool getChunk(const size_t chainId, const Crypto::SHA256::Hash::Ptr hash, std::string& data) const;
+
+    bool importBlocks(const size_t chainId, const std::vector<std::string>& payloads, size_t& index) const;
 
     Block::Ptr getBlock(const size_t chainId, const size_t index) const;
+    Block::Ptr getBlockByHash(const size_t chainId, const std::string& hash) const;
 
     bool getBlocks(const size_t chainId, BlockList& blocks) const;
 
+    bool getBlocks(const size_t chainId,
+        const size_t startIndex,
+        const size_t maxCount,
+        const size_t maxBytes,
+        const bool reverse,
+        BlockList& blocks,
+        size_t& nextIndex) const;
+
+    bool getBlocksByIndex(const BlockIndexList& items, BlockList& blocks) const;
+
     bool removeChain(const size_t chainId) const;
 
+    bool hasChain(const size_t chainId) const;
+
+    bool getReclaimStats(Reclaimer::Stats& stats) const;
+
+    bool listChains(const size_t startId,
+        const size_t maxCount,
+        Catalog::EntryList& entries,
+        size_t& nextId) const;
+
+    bool backupChain(const size_t chainId, const std::string& path) const;
+    bool cloneChain(const size_t chainId, const size_t targetChainId) const;
+
     bool verifyChain(const size_t chainId) const;
 
+    bool setRetention(const size_t chainId, const size_t retainBlocks, const uint64_t retainAge) const;
+    bool pruneChain(const size_t chainId, const uint64_t now, size_t& count) const;
+    bool archiveChain(const size_t chainId, const size_t threshold, size_t& count) const;
+
     Chain::Header::Ptr getChainHeader(const size_t chainId) const;
 
     bool getChainInfo(const size_t chainId, size_t& version, size_t& index) const;
 
+    bool getChainInfo(const size_t chainId, ChainInfo& info) const;
+
+    bool upgradeChains() const;
+
 private:
+    Block::Ptr makeBlock(const Chain::Header::Ptr header,
+        const Crypto::SHA256::Hash::Ptr prevHash,
+        const std::string& data,
+        const Block::Container::ChunkList& chunks = Block::Container::ChunkList()) const;
+
+    Chain::Ptr getChain(const size_t chainId) const;
+    Chain::Ptr makeChain(const size_t chainId) const;
+
+    bool addCatalogEntry(const size_t chainId, const Chain& chain, const uint64_t createdAt) const;
+    void updateCatalogEntries(const Cache::ChainList& chains) const;
+    bool rebuildCatalog() const;
+    bool reclaimChain(const size_t chainId) const;
+
+    bool getChainIds(std::vector<size_t>& chainIds) const;
+
     std::string makeStoragePath(const size_t chainId) const;
+    std::string makeStoragePrefix(const size_t chainId) const;
 
 private:
     Crypto::Secp256k1 _secp256k1;
     std::string _storageDir;
+    std::string _backupDir;
+    Storage::Options _options;
+    Layout _layout;
+    Storage::Ptr _database;
+    Catalog::Ptr _catalog;
+
+    mutable Cache _cache;
+    Syncer _syncer;
+    Pruner _pruner;
+    Reclaimer::Ptr _reclaimer;
 };
 
 }
\ No newline at end of file
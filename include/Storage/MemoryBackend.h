@@ -0,0 +1,172 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+#include "Storage/Storage.h"
+
+namespace Core::Storage
+{
+
+class MemoryBackend : public Storage::Backend
+{
+public:
+    class Table
+    {
+    public:
+        typedef std::shared_ptr<Table> Ptr;
+
+        struct Version
+        {
+            uint64_t sequence;
+            bool deleted;
+            std::string value;
+            Version* prev;
+        };
+
+        struct Node
+        {
+            Node(const std::string& key, const size_t height);
+            ~Node();
+
+            std::string key;
+            std::atomic<Version*> version;
+            std::unique_ptr<std::atomic<Node*>[]> next;
+        };
+
+        Table();
+        ~Table();
+
+        Table(Table const&) = delete;
+        void operator=(Table const&) = delete;
+
+        uint64_t acquire() const;
+        void release() const;
+
+        Node* findGreaterOrEqual(const std::string_view key) const;
+        Node* findLessThan(const std::string_view key) const;
+        Node* findLast() const;
+
+        const Version* getVersion(const Node* node, const uint64_t sequence) const;
+
+        void write(const Storage::KeyValueList& pairs, const Storage::KeyList& keys);
+
+    private:
+        Node* findGreaterOrEqual(const std::string_view key, Node** prev) const;
+
+        void apply(const std::string& key, const std::string* value, const uint64_t sequence);
+        void trim();
+
+        size_t makeHeight();
+
+    private:
+        Node* _head;
+        std::atomic<size_t> _height;
+
+        std::atomic<uint64_t> _sequence;
+        mutable std::atomic<size_t> _readers;
+
+        std::mutex _mutex;
+        std::vector<Node*> _obsolete;
+        uint32_t _random;
+    };
+
+    class Cursor : public Storage::Backend::Cursor
+    {
+    public:
+        explicit Cursor(const Table::Ptr& table);
+        ~Cursor() override;
+
+        void seek(const std::string_view key) override;
+        void next() override;
+        void prev() override;
+
+        bool isValid() const override;
+        bool getStatus() const override;
+
+        std::string_view getKey() const override;
+        std::string_view getValue() const override;
+
+    private:
+        void skipForward();
+        void skipBackward();
+
+    private:
+        Table::Ptr _table;
+        uint64_t _sequence;
+
+        Table::Node* _node;
+        const Table::Version* _version;
+    };
+
+    explicit MemoryBackend(const std::string& path);
+    ~MemoryBackend() override;
+
+    MemoryBackend(MemoryBackend const&) = delete;
+    void operator=(MemoryBackend const&) = delete;
+
+    bool create() override;
+    bool open() override;
+    bool close() override;
+
+    bool exists() const override;
+
+    using Storage::Backend::get;
+
+    bool get(const Storage::KeyValue::Data& key, Storage::Slice& value, bool& isFound) const override;
+    bool multiGet(const Storage::KeyList& keys,
+        std::vector<Storage::Slice>& values,
+        Storage::StatusList& statuses) const override;
+    Storage::Backend::Cursor::Ptr scan(const Storage::ReadOptions& options) const override;
+    bool write(const Storage::KeyValueList& pairs, const Storage::KeyList& keys, const bool sync) const override;
+    bool ingest(const Storage::KeyValueList& pairs) const override;
+    bool checkpoint(const std::string& path) const override;
+    bool reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const override;
+    bool compact(const Storage::KeyValue::Data& start, const Storage::KeyValue::Data& limit) const override;
+
+    bool sync() const override;
+
+    bool getApproximateSize(const Storage::KeyValue::Data& start,
+        const Storage::KeyValue::Data& limit,
+        uint64_t& size) const override;
+
+    bool remove() const override;
+
+private:
+    typedef std::map<std::string, Table::Ptr> TableMap;
+
+    static std::mutex& getTablesMutex();
+    static TableMap& getTables();
+
+private:
+    std::string _path;
+    Table::Ptr _table;
+};
+
+}
@@ -28,6 +28,21 @@ namespace Core::Storage
 {
 
 const std::string DB_HEADER_KEY = "__HEADER";
-const std::string DB_BLOCK_KEY = "__BLOCK/";
+const std::string DB_INDEX_KEY = "__INDEX";
+const std::string DB_SIZE_KEY = "__SIZE";
+const std::string DB_TIP_KEY = "__TIP";
+const std::string DB_DEDUP_KEY = "__DEDUP";
+const std::string DB_PRUNED_KEY = "__PRUNED";
+const std::string DB_ARCHIVE_KEY = "__ARCHIVE";
+const std::string DB_BLOCK_KEY = "B";
+const std::string DB_HASH_KEY = "H";
+const std::string DB_CHUNK_KEY = "C";
+const std::string DB_PAYLOAD_KEY = "P";
+const std::string DB_REFS_KEY = "R";
+const std::string DB_CHUNK_REFS_KEY = "K";
+const std::string DB_LEGACY_BLOCK_KEY = "__BLOCK/";
+const std::string DB_CHAIN_KEY = "__CHAIN/";
+const std::string DB_CATALOG_KEY = "__CATALOG/";
+const std::string DB_TOMBSTONE_KEY = "__TOMBSTONE/";
 
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Storage/Cache.h"
+
+namespace Core::Storage
+{
+
+class Pruner
+{
+public:
+    Pruner(const Cache& cache, const size_t interval, const size_t archiveThreshold);
+    ~Pruner();
+
+    Pruner(Pruner const&) = delete;
+    void operator=(Pruner const&) = delete;
+
+    void start();
+    void stop();
+
+private:
+    void process();
+
+private:
+    const Cache& _cache;
+    std::chrono::milliseconds _interval;
+    size_t _archiveThreshold;
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _isStopped;
+};
+
+}
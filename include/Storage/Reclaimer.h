@@ -0,0 +1,92 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Storage/Catalog.h"
+#include "Storage/Chain.h"
+
+namespace Core::Storage
+{
+
+class Reclaimer
+{
+public:
+    typedef std::shared_ptr<Reclaimer> Ptr;
+    typedef std::function<Chain::Ptr(const size_t chainId)> ChainFactory;
+    typedef std::function<bool(const size_t chainId)> UsageCheck;
+
+    struct Stats
+    {
+        size_t pendingChains;
+        size_t reclaimedChains;
+        uint64_t reclaimedBytes;
+    };
+
+    Reclaimer(const Catalog& catalog,
+        const ChainFactory& factory,
+        const size_t interval,
+        const uint64_t rate,
+        const UsageCheck& isInUse = nullptr);
+    ~Reclaimer();
+
+    Reclaimer(Reclaimer const&) = delete;
+    void operator=(Reclaimer const&) = delete;
+
+    void start();
+    void stop();
+
+    bool reclaimChain(const size_t chainId);
+    bool reclaim(const uint64_t maxBytes);
+
+    bool getStats(Stats& stats) const;
+
+private:
+    void process();
+
+    bool reclaimChain(const size_t chainId, const uint64_t maxBytes, uint64_t& bytes);
+
+private:
+    const Catalog& _catalog;
+    ChainFactory _factory;
+    UsageCheck _isInUse;
+    std::chrono::milliseconds _interval;
+    uint64_t _rate;
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _isStopped;
+
+    std::mutex _reclaimMutex;
+    std::atomic<size_t> _reclaimedChains;
+    std::atomic<uint64_t> _reclaimedBytes;
+};
+
+}
@@ -22,18 +22,21 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #ifdef USE_ROCKSDB
-    #include <rocksdb/db.h>
-    #include <rocksdb/write_batch.h>
+    #include <rocksdb/cache.h>
+    #include <rocksdb/filter_policy.h>
 
     namespace DB = rocksdb;
 #else
-    #include <leveldb/db.h>
-    #include <leveldb/write_batch.h>
+    #include <leveldb/cache.h>
+    #include <leveldb/filter_policy.h>
 
     namespace DB = leveldb;
 #endif
@@ -44,6 +47,30 @@ namespace Core::Storage
 class Storage
 {
 public:
+    typedef std::shared_ptr<Storage> Ptr;
+
+    enum Durability
+    {
+        DEFAULT = 0,
+        SYNC = 1,
+        PERIODIC = 2,
+        ASYNC = 3
+    };
+
+    enum Compression
+    {
+        NONE = 0,
+        SNAPPY = 1,
+        LZ4 = 2,
+        ZSTD = 3
+    };
+
+    enum BackendType
+    {
+        DISK = 0,
+        MEMORY = 1
+    };
+
     struct KeyValue
     {
     public:
@@ -53,8 +80,8 @@ public:
         KeyValue(const Data& key, const Data& value);
         ~KeyValue();
 
-        Data getKey() const;
-        Data getValue() const;
+        const Data& getKey() const;
+        const Data& getValue() const;
 
     private:
         Data _key;
@@ -62,8 +89,151 @@ public:
     };
 
     typedef std::vector<KeyValue> KeyValueList;
+    typedef std::vector<KeyValue::Data> KeyList;
+    typedef std::vector<bool> StatusList;
+
+    class Slice
+    {
+    public:
+        Slice();
+        Slice(const std::string_view data, const std::shared_ptr<void>& owner, const bool isPinned);
+        ~Slice();
+
+        std::string_view getData() const;
+        size_t getSize() const;
+
+        bool isPinned() const;
+
+    private:
+        std::string_view _data;
+        std::shared_ptr<void> _owner;
+        bool _isPinned;
+    };
+
+    struct ReadStats
+    {
+        uint64_t reads;
+        uint64_t bytesRead;
+        uint64_t bytesCopied;
+    };
+
+    struct ReadOptions
+    {
+    public:
+        ReadOptions();
+
+        bool fillCache;
+        size_t readahead;
+    };
+
+    class Backend
+    {
+    public:
+        typedef std::shared_ptr<Backend> Ptr;
+
+        class Cursor
+        {
+        public:
+            typedef std::unique_ptr<Cursor> Ptr;
+
+            virtual ~Cursor() = default;
+
+            virtual void seek(const std::string_view key) = 0;
+            virtual void next() = 0;
+            virtual void prev() = 0;
+
+            virtual bool isValid() const = 0;
+            virtual bool getStatus() const = 0;
+
+            virtual std::string_view getKey() const = 0;
+            virtual std::string_view getValue() const = 0;
+        };
+
+        virtual ~Backend() = default;
+
+        virtual bool create() = 0;
+        virtual bool open() = 0;
+        virtual bool close() = 0;
+
+        virtual bool exists() const = 0;
+
+        virtual bool get(const KeyValue::Data& key, Slice& value, bool& isFound) const = 0;
+        virtual bool multiGet(const KeyList& keys, std::vector<Slice>& values, StatusList& statuses) const = 0;
+        virtual Cursor::Ptr scan(const ReadOptions& options) const = 0;
+        virtual bool write(const KeyValueList& pairs, const KeyList& keys, const bool sync) const = 0;
+        virtual bool ingest(const KeyValueList& pairs) const = 0;
+        virtual bool checkpoint(const std::string& path) const = 0;
+        virtual bool reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const = 0;
+        virtual bool compact(const KeyValue::Data& start, const KeyValue::Data& limit) const = 0;
+
+        virtual bool sync() const = 0;
+
+        virtual bool getApproximateSize(const KeyValue::Data& start,
+            const KeyValue::Data& limit,
+            uint64_t& size) const = 0;
+
+        virtual bool remove() const = 0;
 
-    explicit Storage(const std::string& path);
+        bool get(const KeyValue::Data& key, Slice& value) const;
+        bool copy(const Backend& target, const KeyValue::Data& prefix, const KeyValue::Data& targetPrefix) const;
+    };
+
+    class Iterator
+    {
+    public:
+        typedef std::shared_ptr<Iterator> Ptr;
+
+        Iterator(Backend::Cursor::Ptr cursor, const KeyValue::Data& base, const KeyValue::Data& prefix);
+        ~Iterator();
+
+        Iterator(Iterator const&) = delete;
+        void operator=(Iterator const&) = delete;
+
+        void seek(const KeyValue::Data& key);
+        void next();
+        void prev();
+
+        bool isValid() const;
+        bool getStatus() const;
+
+        KeyValue::Data getKey() const;
+        KeyValue::Data getValue() const;
+
+        std::string_view getValueView() const;
+
+    private:
+        Backend::Cursor::Ptr _cursor;
+        KeyValue::Data _base;
+        KeyValue::Data _prefix;
+    };
+
+    struct Options
+    {
+    public:
+        Options();
+
+        BackendType backend;
+
+        size_t syncInterval;
+        size_t reclaimInterval;
+        uint64_t reclaimRate;
+        size_t pruneInterval;
+        size_t archiveThreshold;
+        std::string backupDir;
+        Compression compression;
+        size_t compressionDictSize;
+
+        size_t blockCacheSize;
+        size_t bloomBitsPerKey;
+        size_t writeBufferSize;
+        size_t maxOpenFiles;
+
+        std::shared_ptr<DB::Cache> blockCache;
+        std::shared_ptr<const DB::FilterPolicy> filterPolicy;
+    };
+
+    explicit Storage(const std::string& path, const Options& options = Options());
+    Storage(const Ptr& parent, const std::string& prefix);
     ~Storage();
 
     Storage(Storage const&) = delete;
@@ -74,14 +244,64 @@ public:
     bool open();
     bool close();
 
+    bool isOpen() const;
+
+    bool exists() const;
+
     KeyValue::Ptr get(const KeyValue::Data& key) const;
-    bool set(const KeyValueList& pairs) const;
+    bool get(const KeyValue::Data& key, Slice& value) const;
+    bool get(const KeyValue::Data& key, Slice& value, bool& isFound) const;
+    bool multiGet(const KeyList& keys, std::vector<Slice>& values, StatusList& statuses) const;
+    Iterator::Ptr scan(const KeyValue::Data& prefix, const ReadOptions& options = ReadOptions()) const;
+    bool set(const KeyValueList& pairs, const Durability durability = SYNC) const;
+    bool replace(const KeyList& keys, const KeyValueList& pairs) const;
+    bool ingest(const KeyValueList& pairs) const;
+
+    bool checkpoint(const std::string& path) const;
+    bool copy(const Storage& target) const;
+
+    bool sync() const;
+
+    bool getApproximateSize(const KeyValue::Data& prefix, uint64_t& size) const;
+
+    bool compact(const KeyValue::Data& prefix) const;
+    bool compact(const KeyValue::Data& start, const KeyValue::Data& limit) const;
+
+    ReadStats getReadStats() const;
 
     bool remove() const;
 
+    bool reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const;
+
+    static bool removeFiles(const std::string& path, const uint64_t maxBytes, uint64_t& bytes, bool& isDone);
+
+    static std::shared_ptr<DB::Cache> makeBlockCache(const size_t size);
+    static std::shared_ptr<const DB::FilterPolicy> makeFilterPolicy(const size_t bitsPerKey);
+
+private:
+    Backend::Ptr makeBackend() const;
+
+    bool write(const KeyValueList& pairs, const KeyList& keys, const bool sync) const;
+
+    void countRead(const size_t size, const size_t copied) const;
+
+    KeyValueList makeKeys(const KeyValueList& pairs) const;
+    KeyList makeKeys(const KeyList& keys) const;
+    static KeyValue::Data makeLimit(const KeyValue::Data& prefix);
+
 private:
     std::string _path;
-    DB::DB* _db;
+    Options _options;
+    Backend::Ptr _backend;
+
+    Ptr _parent;
+    std::string _prefix;
+
+    mutable std::atomic<bool> _dirty;
+
+    mutable std::atomic<uint64_t> _reads;
+    mutable std::atomic<uint64_t> _bytesRead;
+    mutable std::atomic<uint64_t> _bytesCopied;
 };
 
 }
\ No newline at end of file
@@ -21,7 +21,9 @@
 */
 
 #include <csignal>
+#include <fstream>
 #include <memory>
+#include <map>
 
 #include "Defs.h"
 #include "ChainDB.h"
@@ -43,8 +45,24 @@ ChainDB& ChainDB::instance()
 
 ChainDB::ChainDB() :
     _daemonize(true),
+    _upgrade(false),
     _logPath("chain_db_service.log"),
+    _storageLayout("separate"),
+    _storageBackend("disk"),
+    _importChainId(0),
     _serverPort(8888),
+    _cacheSize(CHAIN_CACHE_SIZE),
+    _cacheTimeout(CHAIN_CACHE_TIMEOUT),
+    _syncInterval(SYNC_INTERVAL),
+    _reclaimInterval(RECLAIM_INTERVAL),
+    _reclaimRate(RECLAIM_RATE),
+    _pruneInterval(PRUNE_INTERVAL),
+    _archiveThreshold(ARCHIVE_THRESHOLD),
+    _compressionDictSize(COMPRESSION_DICT_SIZE),
+    _blockCacheSize(BLOCK_CACHE_SIZE),
+    _bloomBitsPerKey(BLOOM_BITS_PER_KEY),
+    _writeBufferSize(WRITE_BUFFER_SIZE),
+    _maxOpenFiles(MAX_OPEN_FILES),
     _server(nullptr)
 {
 }
@@ -59,8 +77,27 @@ bool ChainDB::initialize(const int argc, const char* argv[])
         {"--daemonize", &_daemonize},
         {"--log-path", &_logPath},
         {"--storage-path", &_storageDir},
+        {"--backup-path", &_backupDir},
+        {"--storage-layout", &_storageLayout},
+        {"--storage-backend", &_storageBackend},
         {"--password", &_password},
-        {"--port", &_serverPort}
+        {"--port", &_serverPort},
+        {"--cache-size", &_cacheSize},
+        {"--cache-timeout", &_cacheTimeout},
+        {"--sync-interval", &_syncInterval},
+        {"--reclaim-interval", &_reclaimInterval},
+        {"--reclaim-rate", &_reclaimRate},
+        {"--prune-interval", &_pruneInterval},
+        {"--archive-threshold", &_archiveThreshold},
+        {"--compression", &_compression},
+        {"--compression-dict-size", &_compressionDictSize},
+        {"--block-cache-size", &_blockCacheSize},
+        {"--bloom-bits-per-key", &_bloomBitsPerKey},
+        {"--write-buffer-size", &_writeBufferSize},
+        {"--max-open-files", &_maxOpenFiles},
+        {"--upgrade", &_upgrade},
+        {"--import-chain", &_importChainId},
+        {"--import-path", &_importPath}
     };
 
     initializeSignalHandler();
@@ -88,7 +125,93 @@ bool ChainDB::initialize(const int argc, const char* argv[])
 
 bool ChainDB::run()
 {
-    Manager manager(_storageDir);
+    Core::Storage::Storage::Options options;
+
+    options.syncInterval = _syncInterval;
+    options.reclaimInterval = _reclaimInterval;
+    options.reclaimRate = _reclaimRate;
+    options.pruneInterval = _pruneInterval;
+    options.archiveThreshold = _archiveThreshold;
+    options.backupDir = _backupDir;
+    options.compressionDictSize = _compressionDictSize;
+    options.blockCacheSize = _blockCacheSize;
+    options.bloomBitsPerKey = _bloomBitsPerKey;
+    options.writeBufferSize = _writeBufferSize;
+    options.maxOpenFiles = _maxOpenFiles;
+
+    if (!_compression.empty())
+    {
+        const std::map<std::string, Core::Storage::Storage::Compression> compressions = {
+            {"none", Core::Storage::Storage::NONE},
+            {"snappy", Core::Storage::Storage::SNAPPY},
+            {"lz4", Core::Storage::Storage::LZ4},
+            {"zstd", Core::Storage::Storage::ZSTD}
+        };
+
+        const auto it = compressions.find(_compression);
+
+        if (it == compressions.end())
+        {
+            Logger::error("Invalid compression ({})", _compression);
+            return false;
+        }
+
+        options.compression = it->second;
+    }
+
+#ifndef USE_ROCKSDB
+    if (options.compression == Core::Storage::Storage::LZ4 || options.compression == Core::Storage::Storage::ZSTD)
+    {
+        Logger::warn("Compression is not supported by LevelDB, Snappy is used instead");
+    }
+#endif
+
+    if (_storageBackend == "memory")
+    {
+        options.backend = Core::Storage::Storage::MEMORY;
+    }
+    else if (_storageBackend != "disk")
+    {
+        Logger::error("Invalid storage backend ({})", _storageBackend);
+        return false;
+    }
+
+    Manager::Layout layout = Manager::SEPARATE;
+
+    if (_storageLayout == "shared")
+    {
+        layout = Manager::SHARED;
+    }
+    else if (_storageLayout != "separate")
+    {
+        Logger::error("Invalid storage layout ({})", _storageLayout);
+        return false;
+    }
+
+    Manager manager(_storageDir, _cacheSize, _cacheTimeout, options, layout);
+
+    if (_upgrade)
+    {
+        Logger::info("Upgrade chains (Path: {})...", _storageDir);
+
+        const bool status = manager.upgradeChains();
+
+        Logger::shutdown();
+
+        return status;
+    }
+
+    if (_importChainId)
+    {
+        Logger::info("Import chain (Chain ID: {}, Path: {})...", _importChainId, _importPath);
+
+        const bool status = importChain(manager);
+
+        Logger::shutdown();
+
+        return status;
+    }
+
     Handler handler(manager, _password);
 
     Logger::info("Start (Version: {})...", SERVICE_VERSION);
@@ -148,6 +271,50 @@ bool ChainDB::initializeRandomGenerator() const
     return true;
 }
 
+bool ChainDB::importChain(const Manager& manager) const
+{
+    std::ifstream stream(_importPath);
+
+    if (!stream)
+    {
+        Logger::error("Can\'t open file (Path: {})", _importPath);
+        return false;
+    }
+
+    std::vector<std::string> payloads;
+    std::string line;
+    size_t index = 0;
+
+    while (true)
+    {
+        const bool isEnd = !std::getline(stream, line);
+
+        if (!isEnd)
+        {
+            payloads.push_back(line);
+        }
+
+        if (payloads.size() >= IMPORT_BATCH_SIZE || (isEnd && !payloads.empty()))
+        {
+            if (!manager.importBlocks(_importChainId, payloads, index))
+            {
+                return false;
+            }
+
+            Logger::info("Imported blocks (Chain ID: {}, Index: {})", _importChainId, index);
+
+            payloads.clear();
+        }
+
+        if (isEnd)
+        {
+            break;
+        }
+    }
+
+    return stream.eof();
+}
+
 void ChainDB::signalHandler(const int signum)
 {
     if (signum == SIGINT || signum == SIGTERM)
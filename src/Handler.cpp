@@ -20,6 +20,8 @@
    SOFTWARE.
 */
 
+#include <algorithm>
+
 #include "System/Logger.h"
 #include "Crypto/SHA256.h"
 
@@ -73,22 +75,54 @@ Message::Ptr Handler::handleMessage(const Message::Ptr msg) const
     {
         return handleRemoveChainRequest(req.remove_chain_request());
     }
+    else if (req.has_backup_chain_request())
+    {
+        return handleBackupChainRequest(req.backup_chain_request());
+    }
+    else if (req.has_clone_chain_request())
+    {
+        return handleCloneChainRequest(req.clone_chain_request());
+    }
     else if (req.has_add_block_request())
     {
         return handleAddBlockRequest(req.add_block_request());
     }
+    else if (req.has_import_blocks_request())
+    {
+        return handleImportBlocksRequest(req.import_blocks_request());
+    }
+    else if (req.has_upload_chunk_request())
+    {
+        return handleUploadChunkRequest(req.upload_chunk_request());
+    }
+    else if (req.has_get_chunk_request())
+    {
+        return handleGetChunkRequest(req.get_chunk_request());
+    }
     else if (req.has_get_block_request())
     {
         return handleGetBlockRequest(req.get_block_request());
     }
+    else if (req.has_get_block_by_hash_request())
+    {
+        return handleGetBlockByHashRequest(req.get_block_by_hash_request());
+    }
     else if (req.has_get_blocks_request())
     {
         return handleGetBlocksRequest(req.get_blocks_request());
     }
+    else if (req.has_get_blocks_by_index_request())
+    {
+        return handleGetBlocksByIndexRequest(req.get_blocks_by_index_request());
+    }
     else if (req.has_verify_chain_request())
     {
         return handleVerifyChainRequest(req.verify_chain_request());
     }
+    else if (req.has_set_retention_request())
+    {
+        return handleSetRetentionRequest(req.set_retention_request());
+    }
     else if (req.has_get_chain_header_request())
     {
         return handleGetChainHeaderRequest(req.get_chain_header_request());
@@ -101,6 +135,14 @@ Message::Ptr Handler::handleMessage(const Message::Ptr msg) const
     {
         return handleGetChainInfoRequest(req.get_chain_info_request());
     }
+    else if (req.has_list_chains_request())
+    {
+        return handleListChainsRequest(req.list_chains_request());
+    }
+    else if (req.has_get_stats_request())
+    {
+        return handleGetStatsRequest(req.get_stats_request());
+    }
 
     return makeStatus(NOT_SUPPORTED, "Method isn\'t supported");
 }
@@ -121,7 +163,21 @@ Network::Message::Ptr Handler::handleCreateChainRequest(const Service::IPC::Crea
         return makeStatus(DATA_ERROR, "Can\'t create chain (Data field size is too large)");
     }
 
-    const Storage::Chain::Ptr chain = _manager.createChain(req.chain_id(), req.data());
+    if (req.durability() > Storage::Storage::ASYNC)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t create chain (Invalid durability mode)");
+    }
+
+    if (req.engine() > Storage::Chain::LOG)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t create chain (Invalid storage engine)");
+    }
+
+    const Storage::Chain::Ptr chain = _manager.createChain(req.chain_id(),
+        req.data(),
+        static_cast<Storage::Storage::Durability>(req.durability()),
+        static_cast<Storage::Chain::Engine>(req.engine()),
+        req.dedup());
 
     if (!chain)
     {
@@ -143,6 +199,35 @@ Network::Message::Ptr Handler::handleRemoveChainRequest(const Service::IPC::Remo
     return makeStatus(SUCCESS);
 }
 
+Network::Message::Ptr Handler::handleBackupChainRequest(const Service::IPC::BackupChainRequest& req) const
+{
+    Logger::info("Handle backup chain request (Chain ID: {}, Path: {})", req.chain_id(), req.path());
+
+    if (req.path().empty())
+    {
+        return makeStatus(DATA_ERROR, "Can\'t backup chain (Empty path)");
+    }
+
+    if (!_manager.backupChain(req.chain_id(), req.path()))
+    {
+        return makeStatus(ERROR, "Can\'t backup chain");
+    }
+
+    return makeStatus(SUCCESS);
+}
+
+Network::Message::Ptr Handler::handleCloneChainRequest(const Service::IPC::CloneChainRequest& req) const
+{
+    Logger::info("Handle clone chain request (Chain ID: {}, Target Chain ID: {})", req.chain_id(), req.target_chain_id());
+
+    if (!_manager.cloneChain(req.chain_id(), req.target_chain_id()))
+    {
+        return makeStatus(ERROR, "Can\'t clone chain");
+    }
+
+    return makeStatus(SUCCESS);
+}
+
 Network::Message::Ptr Handler::handleAddBlockRequest(const Service::IPC::AddBlockRequest& req) const
 {
     Logger::info("Handle add block request (Chain ID: {})", req.chain_id());
@@ -152,7 +237,34 @@ Network::Message::Ptr Handler::handleAddBlockRequest(const Service::IPC::AddBloc
         return makeStatus(DATA_ERROR, "Can\'t create chain (Data field size is too large)");
     }
 
-    const Storage::Block::Ptr block = _manager.addBlock(req.chain_id(), req.data());
+    if (req.durability() > Storage::Storage::ASYNC)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t add block (Invalid durability mode)");
+    }
+
+    if (req.chunks_size() > MAX_CHUNK_COUNT)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t add block (Too many chunks)");
+    }
+
+    Storage::Block::Container::ChunkList chunks;
+
+    for (const std::string& chunk : req.chunks())
+    {
+        const Crypto::SHA256::Hash::Ptr hash = makeHash(chunk);
+
+        if (!hash)
+        {
+            return makeStatus(DATA_ERROR, "Can\'t add block (Invalid chunk hash length)");
+        }
+
+        chunks.push_back(hash);
+    }
+
+    const Storage::Block::Ptr block = _manager.addBlock(req.chain_id(),
+        req.data(),
+        static_cast<Storage::Storage::Durability>(req.durability()),
+        chunks);
 
     if (!block)
     {
@@ -168,6 +280,85 @@ Network::Message::Ptr Handler::handleAddBlockRequest(const Service::IPC::AddBloc
     return makeResponse(resp);
 }
 
+Network::Message::Ptr Handler::handleUploadChunkRequest(const Service::IPC::UploadChunkRequest& req) const
+{
+    Logger::info("Handle upload chunk request (Chain ID: {}, Size: {})", req.chain_id(), req.data().size());
+
+    if (req.data().empty() || req.data().size() > MAX_CHUNK_LENGTH)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t upload chunk (Invalid chunk size)");
+    }
+
+    const Crypto::SHA256::Hash::Ptr hash = _manager.addChunk(req.chain_id(), req.data());
+
+    if (!hash)
+    {
+        return makeStatus(ERROR, "Can\'t upload chunk");
+    }
+
+    Service::IPC::Response resp;
+
+    resp.mutable_status()->set_status(SUCCESS);
+    resp.mutable_upload_chunk_response()->set_hash(hash->data(), hash->length());
+
+    return makeResponse(resp);
+}
+
+Network::Message::Ptr Handler::handleGetChunkRequest(const Service::IPC::GetChunkRequest& req) const
+{
+    Logger::info("Handle get chunk request (Chain ID: {})", req.chain_id());
+
+    const Crypto::SHA256::Hash::Ptr hash = makeHash(req.hash());
+
+    if (!hash)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t get chunk (Invalid hash length)");
+    }
+
+    Service::IPC::Response resp;
+
+    if (!_manager.getChunk(req.chain_id(), hash, *resp.mutable_get_chunk_response()->mutable_data()))
+    {
+        return makeStatus(ERROR, "Can\'t get chunk");
+    }
+
+    resp.mutable_status()->set_status(SUCCESS);
+
+    return makeResponse(resp);
+}
+
+Network::Message::Ptr Handler::handleImportBlocksRequest(const Service::IPC::ImportBlocksRequest& req) const
+{
+    Logger::info("Handle import blocks request (Chain ID: {}, Count: {})", req.chain_id(), req.data_size());
+
+    if (req.data_size() > IMPORT_BATCH_SIZE)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t import blocks (Too many blocks)");
+    }
+
+    for (const std::string& data : req.data())
+    {
+        if (data.size() > MAX_DATA_LENGTH)
+        {
+            return makeStatus(DATA_ERROR, "Can\'t import blocks (Data field size is too large)");
+        }
+    }
+
+    size_t index = 0;
+
+    if (!_manager.importBlocks(req.chain_id(), {req.data().begin(), req.data().end()}, index))
+    {
+        return makeStatus(ERROR, "Can\'t import blocks");
+    }
+
+    Service::IPC::Response resp;
+
+    resp.mutable_status()->set_status(SUCCESS);
+    resp.mutable_import_blocks_response()->set_index(index);
+
+    return makeResponse(resp);
+}
+
 Network::Message::Ptr Handler::handleGetBlockRequest(const Service::IPC::GetBlockRequest& req) const
 {
     Logger::info("Handle get block request (Chain ID: {}, Block ID: {})", req.chain_id(), req.block_id());
@@ -188,13 +379,42 @@ Network::Message::Ptr Handler::handleGetBlockRequest(const Service::IPC::GetBloc
     return makeResponse(resp);
 }
 
+Network::Message::Ptr Handler::handleGetBlockByHashRequest(const Service::IPC::GetBlockByHashRequest& req) const
+{
+    Logger::info("Handle get block by hash request (Chain ID: {})", req.chain_id());
+
+    if (req.hash().size() != SHA256_DIGEST_LENGTH)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t get block (Invalid hash length)");
+    }
+
+    const Storage::Block::Ptr block = _manager.getBlockByHash(req.chain_id(), req.hash());
+
+    if (!block)
+    {
+        return makeStatus(ERROR, "Can\'t get block");
+    }
+
+    Service::IPC::Response resp;
+
+    resp.mutable_status()->set_status(SUCCESS);
+
+    setBlockData(resp.mutable_get_block_by_hash_response()->mutable_block(), block);
+
+    return makeResponse(resp);
+}
+
 Network::Message::Ptr Handler::handleGetBlocksRequest(const Service::IPC::GetBlocksRequest& req) const
 {
     Logger::info("Handle get blocks request (Chain ID: {})", req.chain_id());
 
+    const size_t maxCount = req.max_count() ? std::min<size_t>(req.max_count(), GET_BLOCKS_MAX_COUNT) : GET_BLOCKS_MAX_COUNT;
+    const size_t maxBytes = req.max_bytes() ? std::min<size_t>(req.max_bytes(), GET_BLOCKS_MAX_BYTES) : GET_BLOCKS_MAX_BYTES;
+
     Storage::Manager::BlockList blocks;
+    size_t nextIndex = 0;
 
-    if (!_manager.getBlocks(req.chain_id(), blocks))
+    if (!_manager.getBlocks(req.chain_id(), req.start_index(), maxCount, maxBytes, req.reverse(), blocks, nextIndex))
     {
         return makeStatus(ERROR, "Can\'t get blocks");
     }
@@ -203,11 +423,57 @@ Network::Message::Ptr Handler::handleGetBlocksRequest(const Service::IPC::GetBlo
 
     resp.mutable_status()->set_status(SUCCESS);
 
-    for (const Storage::Block::Ptr block : blocks)
+    for (const Storage::Block::Ptr& block : blocks)
     {
         setBlockData(resp.mutable_get_blocks_response()->add_blocks(), block);
     }
 
+    resp.mutable_get_blocks_response()->set_next_index(nextIndex);
+
+    return makeResponse(resp);
+}
+
+Network::Message::Ptr Handler::handleGetBlocksByIndexRequest(const Service::IPC::GetBlocksByIndexRequest& req) const
+{
+    Logger::info("Handle get blocks by index request (Count: {})", req.items_size());
+
+    if (req.items_size() > GET_BLOCKS_MAX_COUNT)
+    {
+        return makeStatus(DATA_ERROR, "Can\'t get blocks (Too many items)");
+    }
+
+    Storage::Manager::BlockIndexList items;
+
+    items.reserve(req.items_size());
+
+    for (const Service::IPC::BlockIndex& item : req.items())
+    {
+        items.push_back({item.chain_id(), item.index()});
+    }
+
+    Storage::Manager::BlockList blocks;
+
+    if (!_manager.getBlocksByIndex(items, blocks))
+    {
+        return makeStatus(ERROR, "Can\'t get blocks");
+    }
+
+    Service::IPC::Response resp;
+
+    resp.mutable_status()->set_status(SUCCESS);
+
+    for (const Storage::Block::Ptr& block : blocks)
+    {
+        Service::IPC::BlockResult* result = resp.mutable_get_blocks_by_index_response()->add_results();
+
+        result->set_status(block ? SUCCESS : ERROR);
+
+        if (block)
+        {
+            setBlockData(result->mutable_block(), block);
+        }
+    }
+
     return makeResponse(resp);
 }
 
@@ -223,6 +489,19 @@ Network::Message::Ptr Handler::handleVerifyChainRequest(const Service::IPC::Veri
     return makeStatus(SUCCESS);
 }
 
+Network::Message::Ptr Handler::handleSetRetentionRequest(const Service::IPC::SetRetentionRequest& req) const
+{
+    Logger::info("Handle set retention request (Chain ID: {}, Blocks: {}, Age: {})",
+        req.chain_id(), req.retain_blocks(), req.retain_age());
+
+    if (!_manager.setRetention(req.chain_id(), req.retain_blocks(), req.retain_age()))
+    {
+        return makeStatus(ERROR, "Can\'t set retention policy");
+    }
+
+    return makeStatus(SUCCESS);
+}
+
 Network::Message::Ptr Handler::handleGetChainHeaderRequest(const Service::IPC::GetChainHeaderRequest& req) const
 {
     Logger::info("Handle get chain header request (Chain ID: {})", req.chain_id());
@@ -291,10 +570,9 @@ Network::Message::Ptr Handler::handleGetChainInfoRequest(const Service::IPC::Get
 {
     Logger::info("Handle get chain info request (Chain ID: {})", req.chain_id());
 
-    size_t version = 0;
-    size_t index = 0;
+    Storage::Manager::ChainInfo info;
 
-    if (!_manager.getChainInfo(req.chain_id(), version, index))
+    if (!_manager.getChainInfo(req.chain_id(), info))
     {
         return makeStatus(ERROR, "Can\'t get chain info");
     }
@@ -304,8 +582,80 @@ Network::Message::Ptr Handler::handleGetChainInfoRequest(const Service::IPC::Get
     resp.mutable_status()->set_status(SUCCESS);
 
     resp.mutable_get_chain_info_response()->set_chain_id(req.chain_id());
-    resp.mutable_get_chain_info_response()->set_version(version);
-    resp.mutable_get_chain_info_response()->set_index(index);
+    resp.mutable_get_chain_info_response()->set_version(info.version);
+    resp.mutable_get_chain_info_response()->set_index(info.index);
+    resp.mutable_get_chain_info_response()->set_durability(info.durability);
+    resp.mutable_get_chain_info_response()->set_engine(info.engine);
+    resp.mutable_get_chain_info_response()->set_data_size(info.dataSize);
+    resp.mutable_get_chain_info_response()->set_storage_size(info.storageSize);
+    resp.mutable_get_chain_info_response()->set_compression_ratio(info.storageSize ?
+        static_cast<double>(info.dataSize) / info.storageSize : 0);
+    resp.mutable_get_chain_info_response()->set_dedup(info.dedup);
+    resp.mutable_get_chain_info_response()->set_payload_size(info.payloadSize);
+    resp.mutable_get_chain_info_response()->set_stored_payload_size(info.storedPayloadSize);
+    resp.mutable_get_chain_info_response()->set_dedup_ratio(info.storedPayloadSize ?
+        static_cast<double>(info.payloadSize) / info.storedPayloadSize : 0);
+    resp.mutable_get_chain_info_response()->set_retain_blocks(info.retainBlocks);
+    resp.mutable_get_chain_info_response()->set_retain_age(info.retainAge);
+    resp.mutable_get_chain_info_response()->set_pruned_index(info.prunedIndex);
+    resp.mutable_get_chain_info_response()->set_archived_index(info.archivedIndex);
+    resp.mutable_get_chain_info_response()->set_archive_size(info.archiveSize);
+
+    return makeResponse(resp);
+}
+
+Network::Message::Ptr Handler::handleListChainsRequest(const Service::IPC::ListChainsRequest& req) const
+{
+    Logger::info("Handle list chains request (Start ID: {})", req.start_id());
+
+    const size_t maxCount = req.max_count() ? std::min<size_t>(req.max_count(), LIST_CHAINS_MAX_COUNT) : LIST_CHAINS_MAX_COUNT;
+
+    Storage::Catalog::EntryList entries;
+    size_t nextId = 0;
+
+    if (!_manager.listChains(req.start_id(), maxCount, entries, nextId))
+    {
+        return makeStatus(ERROR, "Can\'t list chains");
+    }
+
+    Service::IPC::Response resp;
+
+    resp.mutable_status()->set_status(SUCCESS);
+
+    for (const Storage::Catalog::Entry& entry : entries)
+    {
+        Service::IPC::ChainEntry* data = resp.mutable_list_chains_response()->add_chains();
+
+        data->set_chain_id(entry.chainId);
+        data->set_layout(entry.layout);
+        data->set_created_at(entry.createdAt);
+        data->set_index(entry.index);
+        data->set_data_size(entry.dataSize);
+    }
+
+    resp.mutable_list_chains_response()->set_next_id(nextId);
+
+    return makeResponse(resp);
+}
+
+Network::Message::Ptr Handler::handleGetStatsRequest(const Service::IPC::GetStatsRequest&) const
+{
+    Logger::info("Handle get stats request");
+
+    Storage::Reclaimer::Stats stats;
+
+    if (!_manager.getReclaimStats(stats))
+    {
+        return makeStatus(ERROR, "Can\'t get stats");
+    }
+
+    Service::IPC::Response resp;
+
+    resp.mutable_status()->set_status(SUCCESS);
+
+    resp.mutable_get_stats_response()->set_pending_removals(stats.pendingChains);
+    resp.mutable_get_stats_response()->set_reclaimed_chains(stats.reclaimedChains);
+    resp.mutable_get_stats_response()->set_reclaimed_bytes(stats.reclaimedBytes);
 
     return makeResponse(resp);
 }
@@ -394,4 +744,34 @@ void Handler::setBlockData(Service::Blockchain::Block* data, const Storage::Bloc
         block->getData()->getSignature()->data(),
         block->getData()->getSignature()->length()
     );
+
+    for (const Crypto::SHA256::Hash::Ptr& chunk : block->getData()->getChunks())
+    {
+        data->add_chunks(chunk->data(), chunk->length());
+    }
+
+    if (block->getData()->isPruned() && block->getData()->getPayloadHash())
+    {
+        data->set_payload_hash(
+            block->getData()->getPayloadHash()->data(),
+            block->getData()->getPayloadHash()->length()
+        );
+    }
+
+    data->set_timestamp(block->getData()->getTimestamp());
+    data->set_pruned(block->getData()->isPruned());
+}
+
+Crypto::SHA256::Hash::Ptr Handler::makeHash(const std::string& data) const
+{
+    Crypto::SHA256::Hash::Value hash;
+
+    if (data.size() != sizeof(hash))
+    {
+        return nullptr;
+    }
+
+    std::memcpy(hash, data.data(), sizeof(hash));
+
+    return std::make_shared<Crypto::SHA256::Hash>(hash);
 }
@@ -0,0 +1,809 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <zlib.h>
+
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+#include "Storage/Archive.h"
+#include "Storage/Encoding.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+const uint64_t ARCHIVE_MAGIC = 0x434841494e415243;
+const uint32_t ARCHIVE_FORMAT = 1;
+const size_t FRAME_ENTRY_SIZE = 24;
+const size_t FOOTER_SIZE = 40;
+
+Archive::File::File(const std::string& path, const size_t first) :
+    path(path),
+    first(first),
+    count(0),
+    length(0),
+    dataSize(0),
+    map(nullptr),
+    mapLength(0)
+{
+}
+
+Archive::File::~File()
+{
+    if (map)
+    {
+        munmap(const_cast<char*>(map), mapLength);
+    }
+}
+
+Archive::Archive(const std::string& path, const size_t frameSize) :
+    _path(path),
+    _frameSize(frameSize),
+    _isOpen(false),
+    _cacheFrame(0)
+{
+}
+
+Archive::~Archive()
+{
+}
+
+bool Archive::open()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_isOpen)
+    {
+        Logger::error("Archive already open (Path: {})", _path);
+        return false;
+    }
+
+    std::error_code error;
+
+    if (!std::filesystem::exists(_path, error))
+    {
+        if (error)
+        {
+            Logger::error("Can\'t open archive ({})", error.message());
+            return false;
+        }
+
+        _files.clear();
+        _isOpen = true;
+
+        return true;
+    }
+
+    std::filesystem::directory_iterator it(_path, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t open archive ({})", error.message());
+        return false;
+    }
+
+    std::vector<size_t> firsts;
+
+    for (const std::filesystem::directory_entry& entry : it)
+    {
+        if (entry.path().extension() != ".arc")
+        {
+            continue;
+        }
+
+        const std::string& name = entry.path().stem().string();
+
+        if (name.empty() || name.find_first_not_of("0123456789") != std::string::npos)
+        {
+            Logger::error("Invalid archive file (Path: {})", entry.path().string());
+            return false;
+        }
+
+        firsts.push_back(std::stoull(name));
+    }
+
+    std::sort(firsts.begin(), firsts.end());
+
+    std::vector<File::Ptr> files;
+
+    for (const size_t first : firsts)
+    {
+        const File::Ptr file = load(makeFilePath(first));
+
+        if (!file)
+        {
+            return false;
+        }
+
+        const size_t expected = files.empty() ? 1 : files.back()->first + files.back()->count;
+
+        if (file->first != first || file->first != expected)
+        {
+            Logger::error("Invalid archive sequence (Path: {})", file->path);
+            return false;
+        }
+
+        files.push_back(file);
+    }
+
+    _files = files;
+    _isOpen = true;
+
+    return true;
+}
+
+bool Archive::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Archive is not open (Path: {})", _path);
+        return false;
+    }
+
+    _files.clear();
+    _cacheFile = nullptr;
+    _cacheData.clear();
+    _isOpen = false;
+
+    return true;
+}
+
+bool Archive::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _isOpen;
+}
+
+bool Archive::append(const size_t first, const DataList& records)
+{
+    std::string tmpPath;
+
+    return prepare(first, records, tmpPath) && publish(first, tmpPath);
+}
+
+bool Archive::prepare(const size_t first, const DataList& records, std::string& tmpPath) const
+{
+    tmpPath.clear();
+
+    if (records.empty())
+    {
+        return true;
+    }
+
+    std::string buffer;
+    std::string index;
+
+    for (size_t i = 0; i < records.size();)
+    {
+        size_t last = i;
+        size_t rawLength = sizeof(uint32_t);
+
+        while (last < records.size() &&
+            (last == i || rawLength + sizeof(uint32_t) + records[last].size() <= _frameSize))
+        {
+            rawLength += sizeof(uint32_t) + records[last].size();
+            last++;
+        }
+
+        std::string raw(sizeof(uint32_t) * (last - i + 1), '\0');
+
+        Encoding::writeUInt32(&raw[0], last - i);
+
+        for (size_t j = i; j < last; j++)
+        {
+            Encoding::writeUInt32(&raw[sizeof(uint32_t) * (j - i + 1)], records[j].size());
+        }
+
+        for (size_t j = i; j < last; j++)
+        {
+            raw.append(records[j]);
+        }
+
+        uLongf length = compressBound(raw.size());
+
+        std::string frame(length, '\0');
+
+        if (compress2(reinterpret_cast<Bytef*>(frame.data()), &length,
+            reinterpret_cast<const Bytef*>(raw.data()), raw.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+        {
+            Logger::error("Can\'t compress archive frame (Path: {})", _path);
+            return false;
+        }
+
+        std::string entry = Encoding::encodeUInt64(first + i) + Encoding::encodeUInt64(buffer.size());
+
+        entry.resize(FRAME_ENTRY_SIZE);
+
+        Encoding::writeUInt32(&entry[16], length);
+        Encoding::writeUInt32(&entry[20], raw.size());
+
+        index.append(entry);
+        buffer.append(frame.data(), length);
+
+        i = last;
+    }
+
+    std::string footer = Encoding::encodeUInt64(ARCHIVE_MAGIC) +
+        Encoding::encodeUInt64(first) +
+        Encoding::encodeUInt64(records.size()) +
+        Encoding::encodeUInt64(buffer.size());
+
+    footer.resize(FOOTER_SIZE);
+
+    Encoding::writeUInt32(&footer[32], Encoding::crc32(index.data(), index.size()));
+    Encoding::writeUInt32(&footer[36], ARCHIVE_FORMAT);
+
+    buffer.append(index);
+    buffer.append(footer);
+
+    std::error_code error;
+
+    std::filesystem::create_directories(_path, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t create archive ({})", error.message());
+        return false;
+    }
+
+    const std::string& path = makeFilePath(first) + ".tmp";
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t create archive file ({})", strerror(errno));
+        return false;
+    }
+
+    const bool status = write(fd, 0, buffer.data(), buffer.size()) && !fsync(fd);
+
+    ::close(fd);
+
+    if (!status)
+    {
+        Logger::error("Can\'t write archive file (Path: {})", path);
+        std::filesystem::remove(path, error);
+        return false;
+    }
+
+    tmpPath = path;
+
+    return true;
+}
+
+bool Archive::publish(const size_t first, const std::string& tmpPath)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::error_code error;
+
+    if (!_isOpen)
+    {
+        Logger::error("Archive is not open (Path: {})", _path);
+        std::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    if (first != getCount() + 1)
+    {
+        Logger::error("Archive is out of sync (Path: {}, Index: {})", _path, first);
+        std::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    if (tmpPath.empty())
+    {
+        return true;
+    }
+
+    const std::string& path = makeFilePath(first);
+
+    if (std::rename(tmpPath.c_str(), path.c_str()))
+    {
+        Logger::error("Can\'t publish archive file (Path: {})", path);
+        std::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    // The rename must be durable before the chain drops the archived blocks
+    if (!syncDirectory())
+    {
+        Logger::error("Can\'t publish archive file (Path: {})", path);
+        std::filesystem::remove(path, error);
+        return false;
+    }
+
+    const File::Ptr file = load(path);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    _files.push_back(file);
+
+    return true;
+}
+
+bool Archive::get(const size_t index, Data& data) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Archive is not open (Path: {})", _path);
+        return false;
+    }
+
+    const File::Ptr file = find(index);
+
+    if (!file)
+    {
+        Logger::error("Invalid archive index {}", index);
+        return false;
+    }
+
+    const auto it = std::upper_bound(file->frames.begin(), file->frames.end(), index,
+        [](const size_t value, const Frame& frame) {
+            return value < frame.first;
+        });
+
+    const size_t frame = std::distance(file->frames.begin(), it) - 1;
+
+    if ((_cacheFile != file || _cacheFrame != frame) && !decode(file, frame))
+    {
+        return false;
+    }
+
+    const size_t position = index - file->frames[frame].first;
+    const size_t count = Encoding::readUInt32(_cacheData.data());
+
+    if (position >= count || _cacheData.size() < sizeof(uint32_t) * (count + 1))
+    {
+        Logger::error("Corrupted archive frame (Path: {}, Index: {})", file->path, index);
+        return false;
+    }
+
+    uint64_t offset = sizeof(uint32_t) * (count + 1);
+
+    for (size_t i = 0; i < position; i++)
+    {
+        offset += Encoding::readUInt32(&_cacheData[sizeof(uint32_t) * (i + 1)]);
+    }
+
+    const size_t length = Encoding::readUInt32(&_cacheData[sizeof(uint32_t) * (position + 1)]);
+
+    if (offset + length > _cacheData.size())
+    {
+        Logger::error("Corrupted archive frame (Path: {}, Index: {})", file->path, index);
+        return false;
+    }
+
+    data.assign(_cacheData.data() + offset, length);
+
+    return true;
+}
+
+bool Archive::truncate(const size_t count)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Archive is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (count > getCount())
+    {
+        Logger::error("Can\'t truncate archive beyond its end (Count: {})", count);
+        return false;
+    }
+
+    _cacheFile = nullptr;
+
+    while (!_files.empty() && _files.back()->first > count)
+    {
+        std::error_code error;
+
+        if (!std::filesystem::remove(_files.back()->path, error) || error)
+        {
+            Logger::error("Can\'t remove archive file (Path: {})", _files.back()->path);
+            return false;
+        }
+
+        _files.pop_back();
+    }
+
+    if (getCount() != count)
+    {
+        Logger::error("Can\'t truncate archive inside a file (Count: {})", count);
+        return false;
+    }
+
+    return true;
+}
+
+bool Archive::remove() const
+{
+    std::error_code error;
+
+    std::filesystem::remove_all(_path, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t remove archive ({})", error.message());
+        return false;
+    }
+
+    return true;
+}
+
+bool Archive::checkpoint(const std::string& path) const
+{
+    std::vector<std::string> paths;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (!_isOpen)
+        {
+            Logger::error("Archive is not open (Path: {})", _path);
+            return false;
+        }
+
+        for (const File::Ptr& file : _files)
+        {
+            paths.push_back(file->path);
+        }
+    }
+
+    if (paths.empty())
+    {
+        return true;
+    }
+
+    std::error_code error;
+
+    if (!std::filesystem::create_directory(path, error))
+    {
+        Logger::error("Can\'t create archive (Path: {})", path);
+        return false;
+    }
+
+    for (const std::string& source : paths)
+    {
+        const std::filesystem::path target = std::filesystem::path(path) / std::filesystem::path(source).filename();
+
+        std::filesystem::create_hard_link(source, target, error);
+
+        if (!error)
+        {
+            continue;
+        }
+
+        Logger::info("Can\'t link archive file, copy it instead ({})", error.message());
+
+        error.clear();
+
+        if (!std::filesystem::copy_file(source, target, error))
+        {
+            Logger::error("Can\'t copy archive file ({})", error.message());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t Archive::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return getCount();
+}
+
+uint64_t Archive::getDataSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t size = 0;
+
+    for (const File::Ptr& file : _files)
+    {
+        size += file->dataSize;
+    }
+
+    return size;
+}
+
+uint64_t Archive::getStorageSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t size = 0;
+
+    for (const File::Ptr& file : _files)
+    {
+        size += file->length;
+    }
+
+    return size;
+}
+
+Archive::File::Ptr Archive::load(const std::string& path) const
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t open archive file ({})", strerror(errno));
+        return nullptr;
+    }
+
+    const off_t length = lseek(fd, 0, SEEK_END);
+
+    std::string footer(FOOTER_SIZE, '\0');
+
+    if (length < static_cast<off_t>(FOOTER_SIZE) || !read(fd, length - FOOTER_SIZE, footer.data(), footer.size()))
+    {
+        Logger::error("Invalid archive file (Path: {})", path);
+
+        ::close(fd);
+        return nullptr;
+    }
+
+    const uint64_t indexOffset = Encoding::readUInt64(&footer[24]);
+    const uint64_t indexLength = length - FOOTER_SIZE - std::min<uint64_t>(indexOffset, length - FOOTER_SIZE);
+
+    if (Encoding::readUInt64(&footer[0]) != ARCHIVE_MAGIC ||
+        Encoding::readUInt32(&footer[36]) != ARCHIVE_FORMAT ||
+        indexOffset > length - FOOTER_SIZE ||
+        indexLength % FRAME_ENTRY_SIZE)
+    {
+        Logger::error("Invalid archive file (Path: {})", path);
+
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::string index(indexLength, '\0');
+
+    const bool status = read(fd, indexOffset, index.data(), index.size());
+
+    ::close(fd);
+
+    if (!status || Encoding::crc32(index.data(), index.size()) != Encoding::readUInt32(&footer[32]))
+    {
+        Logger::error("Archive index checksum mismatch (Path: {})", path);
+        return nullptr;
+    }
+
+    const File::Ptr file = std::make_shared<File>(path, Encoding::readUInt64(&footer[8]));
+
+    file->count = Encoding::readUInt64(&footer[16]);
+    file->length = length;
+
+    for (size_t offset = 0; offset < index.size(); offset += FRAME_ENTRY_SIZE)
+    {
+        const Frame frame = {
+            Encoding::readUInt64(&index[offset]),
+            Encoding::readUInt64(&index[offset + 8]),
+            Encoding::readUInt32(&index[offset + 16]),
+            Encoding::readUInt32(&index[offset + 20])};
+
+        const size_t expected = file->frames.empty() ? file->first : file->frames.back().first + 1;
+
+        if (frame.first < expected || frame.first >= file->first + file->count || frame.offset + frame.length > indexOffset)
+        {
+            Logger::error("Invalid archive index (Path: {})", path);
+            return nullptr;
+        }
+
+        file->frames.push_back(frame);
+        file->dataSize += frame.rawLength;
+    }
+
+    if (file->frames.empty() || file->frames.front().first != file->first)
+    {
+        Logger::error("Invalid archive index (Path: {})", path);
+        return nullptr;
+    }
+
+    return file;
+}
+
+bool Archive::map(const File::Ptr file) const
+{
+    const int fd = ::open(file->path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t open archive file ({})", strerror(errno));
+        return false;
+    }
+
+    void* data = mmap(nullptr, file->length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        Logger::error("Can\'t map archive file ({})", strerror(errno));
+        return false;
+    }
+
+    file->map = static_cast<const char*>(data);
+    file->mapLength = file->length;
+
+    return true;
+}
+
+bool Archive::decode(const File::Ptr file, const size_t frame) const
+{
+    if (!file->map && !map(file))
+    {
+        return false;
+    }
+
+    const Frame& data = file->frames[frame];
+
+    _cacheFile = nullptr;
+    _cacheData.resize(data.rawLength);
+
+    uLongf length = data.rawLength;
+
+    if (uncompress(reinterpret_cast<Bytef*>(_cacheData.data()), &length,
+        reinterpret_cast<const Bytef*>(file->map + data.offset), data.length) != Z_OK ||
+        length != data.rawLength || length < sizeof(uint32_t))
+    {
+        Logger::error("Corrupted archive frame (Path: {}, Frame: {})", file->path, frame);
+        return false;
+    }
+
+    _cacheFile = file;
+    _cacheFrame = frame;
+
+    return true;
+}
+
+bool Archive::read(const int fd, const uint64_t offset, char* data, const size_t length) const
+{
+    size_t done = 0;
+
+    while (done < length)
+    {
+        const ssize_t result = pread(fd, data + done, length - done, offset + done);
+
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (result <= 0)
+        {
+            Logger::error("Can\'t read archive ({})", result ? strerror(errno) : "Unexpected end of file");
+            return false;
+        }
+
+        done += result;
+    }
+
+    return true;
+}
+
+bool Archive::write(const int fd, const uint64_t offset, const char* data, const size_t length) const
+{
+    size_t written = 0;
+
+    while (written < length)
+    {
+        const ssize_t result = pwrite(fd, data + written, length - written, offset + written);
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            Logger::error("Can\'t write archive ({})", strerror(errno));
+            return false;
+        }
+
+        written += result;
+    }
+
+    return true;
+}
+
+Archive::File::Ptr Archive::find(const size_t index) const
+{
+    const auto it = std::upper_bound(_files.begin(), _files.end(), index,
+        [](const size_t value, const File::Ptr& file) {
+            return value < file->first;
+        });
+
+    if (it == _files.begin())
+    {
+        return nullptr;
+    }
+
+    const File::Ptr file = *std::prev(it);
+
+    if (file->count <= index - file->first)
+    {
+        return nullptr;
+    }
+
+    return file;
+}
+
+size_t Archive::getCount() const
+{
+    if (_files.empty())
+    {
+        return 0;
+    }
+
+    return _files.back()->first + _files.back()->count - 1;
+}
+
+bool Archive::syncDirectory() const
+{
+    const int fd = ::open(_path.c_str(), O_RDONLY | O_DIRECTORY);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t open archive directory ({})", strerror(errno));
+        return false;
+    }
+
+    if (fsync(fd))
+    {
+        Logger::error("Can\'t sync archive directory ({})", strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    ::close(fd);
+
+    return true;
+}
+
+std::string Archive::makeFilePath(const size_t first) const
+{
+    std::string name = std::to_string(first);
+
+    name.insert(0, 20 - name.size(), '0');
+
+    return std::filesystem::path(_path) / (name + ".arc");
+}
@@ -25,23 +25,43 @@
 #include "storage.pb.h"
 
 #include "Storage/Block.h"
+#include "Storage/Encoding.h"
 #include "System/Logger.h"
 #include "Crypto/Random.h"
 
 using namespace Core::Storage;
 using namespace Core::Crypto;
 
+const uint8_t BLOCK_FORMAT = 1;
+
+const uint8_t BLOCK_PAYLOAD_HASH = 0x01;
+const uint8_t BLOCK_PRUNED = 0x02;
+
+const size_t BLOCK_PREFIX_SIZE = 20;
+const size_t BLOCK_HEADER_SIZE = BLOCK_PREFIX_SIZE +
+    sizeof(SHA256::Hash::Value) * 2 +
+    sizeof(Block::Container::Nonce::Value) +
+    sizeof(Secp256k1::Signature::Value);
+
 Block::Container::Container(
     const SHA256::Hash::Ptr hash,
     const SHA256::Hash::Ptr prevHash,
     const Nonce::Ptr nonce,
     const Data& data,
-    const Secp256k1::Signature::Ptr signature) :
+    const Secp256k1::Signature::Ptr signature,
+    const ChunkList& chunks,
+    const SHA256::Hash::Ptr payloadHash,
+    const uint64_t timestamp,
+    const bool pruned) :
     _hash(hash),
     _prevHash(prevHash),
     _nonce(nonce),
     _data(data),
-    _signature(signature)
+    _signature(signature),
+    _chunks(chunks),
+    _payloadHash(payloadHash),
+    _timestamp(timestamp),
+    _pruned(pruned)
 {
 }
 
@@ -74,7 +94,183 @@ Core::Crypto::Secp256k1::Signature::Ptr Block::Container::getSignature() const
     return _signature;
 }
 
+Block::Container::ChunkList Block::Container::getChunks() const
+{
+    return _chunks;
+}
+
+Core::Crypto::SHA256::Hash::Ptr Block::Container::getPayloadHash() const
+{
+    return _payloadHash;
+}
+
+uint64_t Block::Container::getTimestamp() const
+{
+    return _timestamp;
+}
+
+bool Block::Container::isPruned() const
+{
+    return _pruned;
+}
+
+Block::Container::Data Block::Container::encodeChunks(const ChunkList& chunks)
+{
+    if (chunks.empty())
+    {
+        return Data();
+    }
+
+    Data data = Encoding::encodeUInt64(chunks.size());
+
+    for (const SHA256::Hash::Ptr& chunk : chunks)
+    {
+        data.append(reinterpret_cast<const char*>(chunk->data()), chunk->length());
+    }
+
+    return data;
+}
+
 bool Block::Container::pack(const Block::Container::Ptr container, Data& outbuf)
+{
+    const Data& data = container->_data;
+    const ChunkList& chunks = container->_chunks;
+    const SHA256::Hash::Ptr& payloadHash = container->_payloadHash;
+
+    if (data.size() > UINT32_MAX || chunks.size() > UINT32_MAX)
+    {
+        return false;
+    }
+
+    const size_t length = BLOCK_HEADER_SIZE +
+        (payloadHash ? sizeof(SHA256::Hash::Value) : 0) +
+        chunks.size() * sizeof(SHA256::Hash::Value) +
+        data.size() +
+        sizeof(uint32_t);
+
+    outbuf.resize(length);
+
+    char* ptr = outbuf.data();
+
+    ptr[0] = 0;
+    ptr[1] = BLOCK_FORMAT;
+    ptr[2] = (payloadHash ? BLOCK_PAYLOAD_HASH : 0) | (container->_pruned ? BLOCK_PRUNED : 0);
+    ptr[3] = 0;
+
+    Encoding::writeUInt32(ptr + 4, chunks.size());
+    Encoding::writeUInt64(ptr + 8, container->_timestamp);
+    Encoding::writeUInt32(ptr + 16, data.size());
+
+    ptr += BLOCK_PREFIX_SIZE;
+
+    const auto write = [&ptr](const auto& value)
+    {
+        std::memcpy(ptr, value->data(), value->length());
+        ptr += value->length();
+    };
+
+    write(container->_hash);
+    write(container->_prevHash);
+    write(container->_nonce);
+    write(container->_signature);
+
+    if (payloadHash)
+    {
+        write(payloadHash);
+    }
+
+    for (const SHA256::Hash::Ptr& chunk : chunks)
+    {
+        write(chunk);
+    }
+
+    Encoding::writeUInt32(ptr, Encoding::crc32(outbuf.data(), ptr - outbuf.data()));
+
+    std::memcpy(ptr + sizeof(uint32_t), data.data(), data.size());
+
+    return true;
+}
+
+Block::Container::Ptr Block::Container::unpack(const std::string_view inbuf)
+{
+    if (inbuf.empty() || inbuf[0])
+    {
+        return unpackMessage(inbuf);
+    }
+
+    if (inbuf.size() < BLOCK_HEADER_SIZE + sizeof(uint32_t) || inbuf[1] != BLOCK_FORMAT)
+    {
+        return nullptr;
+    }
+
+    const char* ptr = inbuf.data();
+
+    const uint8_t flags = ptr[2];
+
+    if (flags & ~(BLOCK_PAYLOAD_HASH | BLOCK_PRUNED))
+    {
+        return nullptr;
+    }
+
+    const uint64_t chunkCount = Encoding::readUInt32(ptr + 4);
+    const uint64_t timestamp = Encoding::readUInt64(ptr + 8);
+    const uint64_t dataLength = Encoding::readUInt32(ptr + 16);
+
+    const uint64_t headerLength = BLOCK_HEADER_SIZE +
+        ((flags & BLOCK_PAYLOAD_HASH) ? sizeof(SHA256::Hash::Value) : 0) +
+        chunkCount * sizeof(SHA256::Hash::Value);
+
+    if (headerLength + sizeof(uint32_t) + dataLength != inbuf.size() ||
+        Encoding::readUInt32(ptr + headerLength) != Encoding::crc32(ptr, headerLength))
+    {
+        return nullptr;
+    }
+
+    ptr += BLOCK_PREFIX_SIZE;
+
+    const SHA256::Hash::Ptr hash = std::make_shared<SHA256::Hash>(*reinterpret_cast<const SHA256::Hash::Value*>(ptr));
+    ptr += sizeof(SHA256::Hash::Value);
+
+    const SHA256::Hash::Ptr prevHash = std::make_shared<SHA256::Hash>(*reinterpret_cast<const SHA256::Hash::Value*>(ptr));
+    ptr += sizeof(SHA256::Hash::Value);
+
+    const Nonce::Ptr nonce = std::make_shared<Nonce>(*reinterpret_cast<const Nonce::Value*>(ptr));
+    ptr += sizeof(Nonce::Value);
+
+    const Secp256k1::Signature::Ptr signature = std::make_shared<Secp256k1::Signature>(
+        *reinterpret_cast<const Secp256k1::Signature::Value*>(ptr));
+    ptr += sizeof(Secp256k1::Signature::Value);
+
+    SHA256::Hash::Ptr payloadHash;
+
+    if (flags & BLOCK_PAYLOAD_HASH)
+    {
+        payloadHash = std::make_shared<SHA256::Hash>(*reinterpret_cast<const SHA256::Hash::Value*>(ptr));
+        ptr += sizeof(SHA256::Hash::Value);
+    }
+
+    ChunkList chunks;
+
+    chunks.reserve(chunkCount);
+
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        chunks.push_back(std::make_shared<SHA256::Hash>(*reinterpret_cast<const SHA256::Hash::Value*>(ptr)));
+        ptr += sizeof(SHA256::Hash::Value);
+    }
+
+    return std::make_shared<Block::Container>(hash,
+        prevHash,
+        nonce,
+        Data(ptr + sizeof(uint32_t), dataLength),
+        signature,
+        chunks,
+        payloadHash,
+        timestamp,
+        flags & BLOCK_PRUNED);
+}
+
+bool Block::Container::packMessage(const Block::Container::Ptr container, Data& outbuf)
 {
     Service::Blockchain::Block data;
 
@@ -92,14 +288,28 @@ bool Block::Container::pack(const Block::Container::Ptr container, Data& outbuf)
     data.set_signature(container->getSignature()->data(),
         container->getSignature()->length());
 
+    for (const SHA256::Hash::Ptr& chunk : container->getChunks())
+    {
+        data.add_chunks(chunk->data(), chunk->length());
+    }
+
+    if (container->getPayloadHash())
+    {
+        data.set_payload_hash(container->getPayloadHash()->data(),
+            container->getPayloadHash()->length());
+    }
+
+    data.set_timestamp(container->getTimestamp());
+    data.set_pruned(container->isPruned());
+
     return data.SerializeToString(&outbuf);
 }
 
-Block::Container::Ptr Block::Container::unpack(const Data& inbuf)
+Block::Container::Ptr Block::Container::unpackMessage(const std::string_view inbuf)
 {
     Service::Blockchain::Block data;
 
-    if (!data.ParseFromString(inbuf))
+    if (!data.ParseFromArray(inbuf.data(), inbuf.size()))
     {
         return nullptr;
     }
@@ -140,12 +350,48 @@ Block::Container::Ptr Block::Container::unpack(const Data& inbuf)
 
     std::memcpy(signature, data.signature().data(), sizeof(signature));
 
+    ChunkList chunks;
+
+    for (const std::string& chunk : data.chunks())
+    {
+        SHA256::Hash::Value chunkHash;
+
+        if (chunk.size() != sizeof(chunkHash))
+        {
+            return nullptr;
+        }
+
+        std::memcpy(chunkHash, chunk.data(), sizeof(chunkHash));
+
+        chunks.push_back(std::make_shared<Crypto::SHA256::Hash>(chunkHash));
+    }
+
+    SHA256::Hash::Ptr payloadHash;
+
+    if (!data.payload_hash().empty())
+    {
+        SHA256::Hash::Value value;
+
+        if (data.payload_hash().size() != sizeof(value))
+        {
+            return nullptr;
+        }
+
+        std::memcpy(value, data.payload_hash().data(), sizeof(value));
+
+        payloadHash = std::make_shared<Crypto::SHA256::Hash>(value);
+    }
+
     return std::make_shared<Block::Container>(
         std::make_shared<Crypto::SHA256::Hash>(hash),
         std::make_shared<Crypto::SHA256::Hash>(prevHash),
         std::make_shared<Block::Container::Nonce>(nonce),
         data.data(),
-        std::make_shared<Secp256k1::Signature>(signature)
+        std::make_shared<Secp256k1::Signature>(signature),
+        chunks,
+        payloadHash,
+        data.timestamp(),
+        data.pruned()
     );
 }
 
@@ -0,0 +1,237 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include "Storage/Cache.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+Cache::Cache(const size_t capacity, const size_t idleTimeout, const Evictor& evictor) :
+    _capacity(capacity),
+    _idleTimeout(idleTimeout),
+    _evictor(evictor)
+{
+}
+
+Cache::~Cache()
+{
+}
+
+Chain::Ptr Cache::get(const size_t chainId, const Loader& loader)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _condition.wait(lock, [this, chainId]() { return !_loading.count(chainId); });
+
+    const auto it = _index.find(chainId);
+
+    Chain::Ptr chain;
+
+    if (it != _index.end())
+    {
+        _entries.splice(_entries.begin(), _entries, it->second);
+
+        it->second->lastAccess = Clock::now();
+
+        chain = it->second->chain;
+    }
+    else
+    {
+        // Chains are opened outside the lock so that a slow open doesn't stall other requests
+        _loading.insert(chainId);
+
+        lock.unlock();
+
+        chain = loader();
+
+        lock.lock();
+
+        _loading.erase(chainId);
+        _condition.notify_all();
+
+        if (!chain)
+        {
+            return nullptr;
+        }
+
+        _entries.push_front({chainId, chain, Clock::now()});
+        _index[chainId] = _entries.begin();
+    }
+
+    ChainList chains;
+
+    evict(chains);
+    release(lock, chains);
+
+    return chain;
+}
+
+Chain::Ptr Cache::find(const size_t chainId) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto it = _index.find(chainId);
+
+    return it != _index.end() ? it->second->chain : nullptr;
+}
+
+void Cache::remove(const size_t chainId)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto it = _index.find(chainId);
+
+    if (it == _index.end())
+    {
+        return;
+    }
+
+    // Requests and background tasks may still hold the chain, it stays tracked until they release it
+    _removed[chainId] = it->second->chain;
+
+    _entries.erase(it->second);
+    _index.erase(it);
+}
+
+void Cache::clear()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    ChainList chains;
+
+    for (Entry& entry : _entries)
+    {
+        _loading.insert(entry.chainId);
+
+        chains.push_back({entry.chainId, std::move(entry.chain)});
+    }
+
+    _entries.clear();
+    _index.clear();
+
+    release(lock, chains);
+}
+
+bool Cache::isInUse(const size_t chainId)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_index.count(chainId) || _loading.count(chainId))
+    {
+        return true;
+    }
+
+    const auto it = _removed.find(chainId);
+
+    if (it == _removed.end())
+    {
+        return false;
+    }
+
+    if (!it->second.expired())
+    {
+        return true;
+    }
+
+    _removed.erase(it);
+
+    return false;
+}
+
+size_t Cache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _entries.size();
+}
+
+void Cache::forEach(const std::function<void(const Chain::Ptr&)>& callback) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (const Entry& entry : _entries)
+    {
+        callback(entry.chain);
+    }
+}
+
+void Cache::evict(ChainList& chains)
+{
+    const Clock::time_point now = Clock::now();
+
+    EntryList::iterator it = _entries.end();
+
+    while (it != _entries.begin())
+    {
+        --it;
+
+        const bool isExpired = _idleTimeout.count() && now - it->lastAccess >= _idleTimeout;
+        const bool isOverflow = _entries.size() > _capacity;
+
+        // Chains in use by a request keep their handle (DB lock is still held)
+        if ((isExpired || isOverflow) && it->chain.use_count() == 1)
+        {
+            Logger::debug("Close chain (Chain ID: {})", it->chainId);
+
+            _loading.insert(it->chainId);
+
+            chains.push_back({it->chainId, std::move(it->chain)});
+
+            _index.erase(it->chainId);
+            it = _entries.erase(it);
+        }
+    }
+}
+
+void Cache::release(std::unique_lock<std::mutex>& lock, ChainList& chains)
+{
+    if (chains.empty())
+    {
+        return;
+    }
+
+    lock.unlock();
+
+    if (_evictor)
+    {
+        _evictor(chains);
+    }
+
+    std::vector<size_t> chainIds;
+
+    for (const auto& [chainId, chain] : chains)
+    {
+        chainIds.push_back(chainId);
+    }
+
+    // Released chains are closed here, requests for them wait until their DB lock is gone
+    chains.clear();
+
+    lock.lock();
+
+    for (const size_t chainId : chainIds)
+    {
+        _loading.erase(chainId);
+    }
+
+    _condition.notify_all();
+}
@@ -0,0 +1,292 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include "storage.pb.h"
+
+#include "Storage/Catalog.h"
+#include "Storage/Protocol.h"
+#include "Storage/Encoding.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+Catalog::Catalog(const std::string& path, const Storage::Options& options) :
+    _storage(path, options)
+{
+}
+
+Catalog::~Catalog()
+{
+}
+
+bool Catalog::create()
+{
+    return _storage.create();
+}
+
+bool Catalog::open()
+{
+    return _storage.open();
+}
+
+bool Catalog::exists() const
+{
+    return _storage.exists();
+}
+
+bool Catalog::addChain(const Entry& entry) const
+{
+    std::string buffer;
+
+    if (!pack(entry, buffer))
+    {
+        Logger::error("Can\'t serialize catalog entry");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _storage.replace({makeTombstoneName(entry.chainId)}, {{makeEntryName(entry.chainId), buffer}});
+}
+
+bool Catalog::removeChain(const size_t chainId) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _storage.replace({makeEntryName(chainId)}, {{makeTombstoneName(chainId), Encoding::encodeUInt64(chainId)}});
+}
+
+bool Catalog::updateChains(const EntryList& entries, const Storage::Durability durability) const
+{
+    Storage::KeyValueList pairs;
+
+    pairs.reserve(entries.size());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (const Entry& update : entries)
+    {
+        const std::string& name = makeEntryName(update.chainId);
+
+        Entry entry;
+        bool isFound = false;
+
+        if (!getChain(name, entry, isFound))
+        {
+            return false;
+        }
+
+        // Removed chains keep only their tombstone
+        if (!isFound)
+        {
+            continue;
+        }
+
+        entry.index = update.index;
+        entry.dataSize = update.dataSize;
+
+        std::string buffer;
+
+        if (!pack(entry, buffer))
+        {
+            Logger::error("Can\'t serialize catalog entry");
+            return false;
+        }
+
+        pairs.push_back({name, buffer});
+    }
+
+    return pairs.empty() || _storage.set(pairs, durability);
+}
+
+bool Catalog::hasChain(const size_t chainId) const
+{
+    Storage::Slice value;
+    bool isFound = false;
+
+    return _storage.get(makeEntryName(chainId), value, isFound) && isFound;
+}
+
+bool Catalog::hasTombstone(const size_t chainId) const
+{
+    Storage::Slice value;
+    bool isFound = false;
+
+    return _storage.get(makeTombstoneName(chainId), value, isFound) && isFound;
+}
+
+bool Catalog::removeTombstone(const size_t chainId) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _storage.replace({makeTombstoneName(chainId)}, {});
+}
+
+bool Catalog::getTombstones(std::vector<size_t>& chainIds) const
+{
+    const Storage::Iterator::Ptr it = _storage.scan(DB_TOMBSTONE_KEY);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    for (; it->isValid(); it->next())
+    {
+        uint64_t chainId = 0;
+
+        if (!Encoding::decodeUInt64(it->getValueView(), chainId))
+        {
+            Logger::error("Can\'t parse tombstone");
+            return false;
+        }
+
+        chainIds.push_back(chainId);
+    }
+
+    return it->getStatus();
+}
+
+bool Catalog::getChain(const size_t chainId, Entry& entry) const
+{
+    bool isFound = false;
+
+    if (!getChain(makeEntryName(chainId), entry, isFound))
+    {
+        return false;
+    }
+
+    if (!isFound)
+    {
+        Logger::error("Chain is not in catalog (Chain ID: {})", chainId);
+        return false;
+    }
+
+    return true;
+}
+
+bool Catalog::getChains(const size_t startId,
+    const size_t maxCount,
+    EntryList& entries,
+    size_t& nextId) const
+{
+    Storage::ReadOptions options;
+
+    options.fillCache = false;
+
+    const Storage::Iterator::Ptr it = _storage.scan(DB_CATALOG_KEY, options);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    nextId = 0;
+
+    for (it->seek(makeEntryName(startId)); it->isValid(); it->next())
+    {
+        Entry entry;
+
+        if (!unpack(it->getValueView(), entry))
+        {
+            Logger::error("Can\'t parse catalog entry");
+            return false;
+        }
+
+        if (entries.size() >= maxCount)
+        {
+            nextId = entry.chainId;
+            break;
+        }
+
+        entries.push_back(entry);
+    }
+
+    return it->getStatus();
+}
+
+bool Catalog::getChain(const std::string& name, Entry& entry, bool& isFound) const
+{
+    Storage::Slice value;
+
+    if (!_storage.get(name, value, isFound))
+    {
+        return false;
+    }
+
+    if (isFound && !unpack(value.getData(), entry))
+    {
+        Logger::error("Can\'t parse catalog entry");
+        return false;
+    }
+
+    return true;
+}
+
+std::string Catalog::makeEntryName(const size_t chainId) const
+{
+    std::string id = std::to_string(chainId);
+
+    id.insert(0, 20 - id.size(), '0');
+
+    return DB_CATALOG_KEY + id;
+}
+
+std::string Catalog::makeTombstoneName(const size_t chainId) const
+{
+    std::string id = std::to_string(chainId);
+
+    id.insert(0, 20 - id.size(), '0');
+
+    return DB_TOMBSTONE_KEY + id;
+}
+
+bool Catalog::pack(const Entry& entry, std::string& outbuf)
+{
+    Service::Blockchain::CatalogEntry data;
+
+    data.set_chain_id(entry.chainId);
+    data.set_layout(entry.layout);
+    data.set_created_at(entry.createdAt);
+    data.set_index(entry.index);
+    data.set_data_size(entry.dataSize);
+
+    return data.SerializeToString(&outbuf);
+}
+
+bool Catalog::unpack(const std::string_view inbuf, Entry& entry)
+{
+    Service::Blockchain::CatalogEntry data;
+
+    if (!data.ParseFromArray(inbuf.data(), inbuf.size()))
+    {
+        return false;
+    }
+
+    entry.chainId = data.chain_id();
+    entry.layout = data.layout();
+    entry.createdAt = data.created_at();
+    entry.index = data.index();
+    entry.dataSize = data.data_size();
+
+    return true;
+}
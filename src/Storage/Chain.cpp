@@ -20,11 +20,17 @@
    SOFTWARE.
 */
 
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
 #include "storage.pb.h"
 
 #include "Defs.h"
 #include "Storage/Chain.h"
 #include "Storage/Protocol.h"
+#include "Storage/Encoding.h"
 #include "System/Logger.h"
 
 using namespace Core::Storage;
@@ -37,6 +43,11 @@ Chain::Header::Header(
     Secp256k1::PublicKey::Ptr publicKey) :
     _version(version),
     _index(0),
+    _durability(Storage::SYNC),
+    _engine(STORAGE),
+    _dedup(false),
+    _retainBlocks(0),
+    _retainAge(0),
     _data(data),
     _privateKey(privateKey),
     _publicKey(publicKey)
@@ -51,6 +62,11 @@ Chain::Header::Header(
     Secp256k1::PublicKey::Ptr publicKey) :
     _version(version),
     _index(index),
+    _durability(Storage::SYNC),
+    _engine(STORAGE),
+    _dedup(false),
+    _retainBlocks(0),
+    _retainAge(0),
     _data(data),
     _privateKey(privateKey),
     _publicKey(publicKey)
@@ -76,6 +92,56 @@ void Chain::Header::setIndex(size_t index)
     _index = index;
 }
 
+Core::Storage::Storage::Durability Chain::Header::getDurability() const
+{
+    return _durability;
+}
+
+void Chain::Header::setDurability(const Storage::Durability durability)
+{
+    _durability = durability;
+}
+
+Chain::Engine Chain::Header::getEngine() const
+{
+    return _engine;
+}
+
+void Chain::Header::setEngine(const Engine engine)
+{
+    _engine = engine;
+}
+
+bool Chain::Header::isDedup() const
+{
+    return _dedup;
+}
+
+void Chain::Header::setDedup(const bool dedup)
+{
+    _dedup = dedup;
+}
+
+size_t Chain::Header::getRetainBlocks() const
+{
+    return _retainBlocks;
+}
+
+void Chain::Header::setRetainBlocks(const size_t retainBlocks)
+{
+    _retainBlocks = retainBlocks;
+}
+
+uint64_t Chain::Header::getRetainAge() const
+{
+    return _retainAge;
+}
+
+void Chain::Header::setRetainAge(const uint64_t retainAge)
+{
+    _retainAge = retainAge;
+}
+
 Chain::Header::Data Chain::Header::getData() const
 {
     return _data;
@@ -97,6 +163,11 @@ bool Chain::Header::pack(const Chain::Header::Ptr header, Data& outbuf)
 
     data.set_version(header->getVersion());
     data.set_index(header->getIndex());
+    data.set_durability(header->getDurability());
+    data.set_engine(header->getEngine());
+    data.set_dedup(header->isDedup());
+    data.set_retain_blocks(header->getRetainBlocks());
+    data.set_retain_age(header->getRetainAge());
     data.set_data(header->getData());
 
     data.set_private_key(header->getPrivateKey()->data(),
@@ -108,11 +179,11 @@ bool Chain::Header::pack(const Chain::Header::Ptr header, Data& outbuf)
     return data.SerializeToString(&outbuf);
 }
 
-Chain::Header::Ptr Chain::Header::unpack(const Data& inbuf)
+Chain::Header::Ptr Chain::Header::unpack(const std::string_view inbuf)
 {
     Service::Blockchain::Header data;
 
-    if (!data.ParseFromString(inbuf))
+    if (!data.ParseFromArray(inbuf.data(), inbuf.size()))
     {
         return nullptr;
     }
@@ -135,15 +206,47 @@ Chain::Header::Ptr Chain::Header::unpack(const Data& inbuf)
 
     std::memcpy(publicKey, data.public_key().data(), sizeof(publicKey));
 
-    return std::make_shared<Chain::Header>(data.version(),
+    if (data.durability() > Storage::ASYNC || data.engine() > LOG)
+    {
+        return nullptr;
+    }
+
+    const Chain::Header::Ptr header = std::make_shared<Chain::Header>(data.version(),
         data.index(),
         data.data(),
         std::make_shared<Secp256k1::PrivateKey>(privateKey),
         std::make_shared<Secp256k1::PublicKey>(publicKey));
+
+    if (data.durability() != Storage::DEFAULT)
+    {
+        header->setDurability(static_cast<Storage::Durability>(data.durability()));
+    }
+
+    header->setEngine(static_cast<Engine>(data.engine()));
+    header->setDedup(data.dedup());
+    header->setRetainBlocks(data.retain_blocks());
+    header->setRetainAge(data.retain_age());
+
+    return header;
+}
+
+Chain::Chain(const std::string& path, const Storage::Options& options) :
+    _path(path),
+    _logPath(path + ".log"),
+    _archivePath(path + ".archive"),
+    _options(options),
+    _storage(nullptr),
+    _dataSize(0)
+{
 }
 
-Chain::Chain(const std::string& path) :
-    _path(path)
+Chain::Chain(const Storage::Ptr& database, const std::string& prefix, const std::string& logPath) :
+    _path(prefix),
+    _logPath(logPath),
+    _archivePath(std::filesystem::path(logPath).replace_extension(".archive").string()),
+    _database(database),
+    _storage(nullptr),
+    _dataSize(0)
 {
 }
 
@@ -151,72 +254,187 @@ Chain::~Chain()
 {
 }
 
-bool Chain::create(const Chain::Header::Data& data,
-    Secp256k1::PrivateKey::Ptr privateKey,
-    Secp256k1::PublicKey::Ptr publicKey) const
+bool Chain::open()
 {
-    const Chain::Header::Ptr header(new Chain::Header(DB_VERSION, data, privateKey, publicKey));
+    if (_storage)
+    {
+        Logger::error("Chain already open (Path: {})", _path);
+        return false;
+    }
 
-    Chain::Header::Data buffer;
+    const Storage::Ptr storage = makeStorage();
 
-    if (!Chain::Header::pack(header, buffer))
+    if (!storage->open())
+    {
+        return false;
+    }
+
+    if (!upgrade(*storage))
+    {
+        return false;
+    }
+
+    Chain::Header::Ptr header = getHeader(*storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    Log::Ptr log;
+
+    if (header->getEngine() == LOG)
+    {
+        log = std::make_shared<Log>(_logPath);
+
+        if (!log->open() || !recoverLog(*storage, log))
+        {
+            return false;
+        }
+
+        header = getHeader(*storage);
+
+        if (!header)
+        {
+            return false;
+        }
+    }
+
+    Archive::Ptr archive;
+
+    if (header->getEngine() == STORAGE)
+    {
+        archive = std::make_shared<Archive>(_archivePath);
+
+        if (!archive->open() || !recoverArchive(*storage, archive))
+        {
+            return false;
+        }
+    }
+
+    uint64_t dataSize = 0;
+
+    if (!getDataSize(*storage, dataSize))
     {
-        Logger::error("Can\'t serialize header");
         return false;
     }
 
-    Storage storage(_path);
+    const SHA256::Hash::Ptr tipHash = getTipHash(*storage);
 
-    if (!storage.create())
+    if (!tipHash)
     {
         return false;
     }
 
-    if (!storage.set({{DB_HEADER_KEY, buffer}}))
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _header = header;
+    _dataSize = dataSize;
+    _tipHash = tipHash;
+
+    _storage = storage;
+    _log = log;
+    _archive = archive;
+
+    return true;
+}
+
+bool Chain::close()
+{
+    if (!_storage)
     {
+        Logger::error("Chain is not open (Path: {})", _path);
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _storage = nullptr;
+    _log = nullptr;
+    _archive = nullptr;
+
+    _header = nullptr;
+    _tipHash = nullptr;
+
     return true;
 }
 
-bool Chain::addBlock(const Block::Ptr block) const
+bool Chain::isOpen() const
+{
+    return _storage != nullptr;
+}
+
+bool Chain::create(const Chain::Header::Data& data,
+    Secp256k1::PrivateKey::Ptr privateKey,
+    Secp256k1::PublicKey::Ptr publicKey,
+    const Storage::Durability durability,
+    const Engine engine,
+    const bool dedup) const
 {
-    Storage storage(_path);
+    const Chain::Header::Ptr header(new Chain::Header(DB_VERSION, data, privateKey, publicKey));
 
-    if (!storage.open())
+    if (durability != Storage::DEFAULT)
     {
-        return false;
+        header->setDurability(durability);
     }
 
-    const Chain::Header::Ptr header = getHeader(storage);
+    header->setEngine(engine);
+    header->setDedup(dedup);
 
-    if (!header)
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(header, buffer))
     {
+        Logger::error("Can\'t serialize header");
         return false;
     }
 
-    header->setIndex(header->getIndex() + 1);
+    const SHA256::Hash::Ptr genesisHash = makeGenesisHash(header);
 
-    Chain::Header::Data headerData;
+    if (!genesisHash)
+    {
+        return false;
+    }
+
+    const Storage::Ptr storage = makeStorage();
 
-    if (!Chain::Header::pack(header, headerData))
+    if (!storage->create())
     {
-        Logger::error("Can\'t serialize header");
         return false;
     }
 
-    Block::Container::Data blockData;
+    if (engine == LOG)
+    {
+        Log log(_logPath);
+
+        if (!log.remove() || !log.create())
+        {
+            storage->close();
+            storage->remove();
 
-    if (!Block::Container::pack(block->getData(), blockData))
+            return false;
+        }
+    }
+    else if (!Archive(_archivePath).remove())
     {
-        Logger::error("Can\'t serialize block");
+        storage->close();
+        storage->remove();
+
         return false;
     }
 
-    if (!storage.set({
-        {DB_HEADER_KEY, headerData},
-        {makeBlockName(header->getIndex()), blockData}}))
+    Storage::KeyValueList pairs = {
+        {DB_HEADER_KEY, buffer},
+        {DB_INDEX_KEY, Encoding::encodeUInt64(0)},
+        {DB_SIZE_KEY, Encoding::encodeUInt64(0)},
+        {DB_TIP_KEY, encodeHash(genesisHash)}};
+
+    if (dedup)
+    {
+        putPayloads({{}, 0, 0}, pairs);
+    }
+
+    if (!storage->set(pairs))
     {
         return false;
     }
@@ -224,136 +442,2690 @@ bool Chain::addBlock(const Block::Ptr block) const
     return true;
 }
 
-Block::Ptr Chain::getBlock(const size_t index) const
+bool Chain::addBlock(const Block::Ptr block, const Storage::Durability durability) const
 {
-    Storage storage(_path);
+    const Storage::Ptr storage = openStorage();
 
-    if (!storage.open())
+    if (!storage)
     {
-        return nullptr;
+        return false;
     }
 
-    const Chain::Header::Ptr header = getHeader(storage);
+    std::lock_guard<std::mutex> lock(_mutex);
 
-    if (!header)
-    {
-        return nullptr;
-    }
+    return addBlock(*storage, block, durability);
+}
+
+Block::Ptr Chain::addBlock(const BlockBuilder& builder, const Storage::Durability durability) const
+{
+    const Storage::Ptr storage = openStorage();
 
-    if (!index || header->getIndex() < index)
+    if (!storage)
     {
-        Logger::error("Invalid index {}", index);
         return nullptr;
     }
 
-    const Storage::KeyValue::Ptr data = storage.get(makeBlockName(index));
+    std::lock_guard<std::mutex> lock(_mutex);
 
-    if (!data)
+    const SHA256::Hash::Ptr prevHash = _header ? _tipHash : getTipHash(*storage);
+
+    if (!prevHash)
     {
+        Logger::error("Can\'t get tip hash");
         return nullptr;
     }
 
-    Block::Container::Ptr container = Block::Container::unpack(data->getValue());
+    const Block::Ptr block = builder(prevHash);
 
-    if (!container)
+    if (!block || !addBlock(*storage, block, durability))
     {
-        Logger::error("Can\'t parse block (Index: {})", index);
         return nullptr;
     }
 
-    return std::make_shared<Block>(container);
+    return block;
 }
 
-bool Chain::getBlocks(std::vector<Block::Ptr>& blocks) const
+bool Chain::addBlock(const Storage& storage, const Block::Ptr block, const Storage::Durability durability) const
 {
-    Storage storage(_path);
+    size_t index = 0;
+    uint64_t dataSize = 0;
 
-    if (!storage.open())
+    if (_header)
+    {
+        index = _header->getIndex();
+        dataSize = _dataSize;
+    }
+    else if (!getIndex(storage, index) || !getDataSize(storage, dataSize))
     {
         return false;
     }
 
-    const Chain::Header::Ptr header = getHeader(storage);
+    index++;
+
+    const Chain::Header::Ptr header = _header ? _header : getHeader(storage);
 
     if (!header)
     {
         return false;
     }
 
-    for (size_t i = 1; i <= header->getIndex(); i++)
+    Block::Container::Ptr container = block->getData();
+    Storage::KeyValueList payloadPairs;
+
+    if (header->isDedup())
     {
-        const Storage::KeyValue::Ptr value = storage.get(makeBlockName(i));
+        Payloads payloads;
 
-        if (!value)
+        if (!getPayloads(storage, payloads) || !addPayload(storage, container, payloads, payloadPairs))
         {
             return false;
         }
 
-        Block::Container::Ptr container = Block::Container::unpack(value->getValue());
+        putPayloads(payloads, payloadPairs);
+    }
 
-        if (!container)
+    const Block::Container::ChunkList& chunks = container->getChunks();
+
+    if (!chunks.empty())
+    {
+        Refs chunkRefs;
+
+        if (!hasChunks(storage, chunks) || !addChunkRefs(storage, chunks, chunkRefs))
         {
-            Logger::error("Can\'t parse block (Index: {})", i);
             return false;
         }
 
-        blocks.push_back(std::make_shared<Block>(container));
+        putChunkRefs(chunkRefs, payloadPairs);
+    }
+
+    Block::Container::Data blockData;
+
+    if (!Block::Container::pack(container, blockData))
+    {
+        Logger::error("Can\'t serialize block");
+        return false;
+    }
+
+    Log::Ptr log;
+
+    if (!openLog(storage, log))
+    {
+        return false;
+    }
+
+    Storage::KeyValueList pairs = {
+        {DB_INDEX_KEY, Encoding::encodeUInt64(index)},
+        {DB_SIZE_KEY, Encoding::encodeUInt64(dataSize + blockData.size())},
+        {DB_TIP_KEY, encodeHash(block->getData()->getHash())},
+        {makeHashName(block->getData()), Encoding::encodeUInt64(index)}};
+
+    if (log)
+    {
+        if (log->size() != index - 1)
+        {
+            Logger::error("Log is out of sync (Path: {})", _logPath);
+            return false;
+        }
+
+        if (!log->append({blockData}, durability != Storage::PERIODIC && durability != Storage::ASYNC))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        pairs.push_back({makeBlockName(index), blockData});
+    }
+
+    pairs.insert(pairs.end(), payloadPairs.begin(), payloadPairs.end());
+
+    if (!storage.set(pairs, durability))
+    {
+        if (log)
+        {
+            log->truncate(index - 1);
+        }
+
+        return false;
+    }
+
+    if (_header)
+    {
+        _header->setIndex(index);
+        _dataSize = dataSize + blockData.size();
+        _tipHash = block->getData()->getHash();
     }
 
     return true;
 }
 
-bool Chain::remove() const
+bool Chain::importBlocks(const std::vector<Block::Ptr>& blocks) const
 {
-    return Storage(_path).remove();
-}
+    if (blocks.empty())
+    {
+        return true;
+    }
 
-Chain::Header::Ptr Chain::getHeader() const
-{
-    Storage storage(_path);
+    const Storage::Ptr storage = openStorage();
 
-    if (!storage.open())
+    if (!storage)
     {
-        return nullptr;
+        return false;
     }
 
-    const Storage::KeyValue::Ptr value = storage.get(DB_HEADER_KEY);
+    std::lock_guard<std::mutex> lock(_mutex);
 
-    if (!value)
+    size_t index = 0;
+    uint64_t dataSize = 0;
+    SHA256::Hash::Ptr tipHash;
+
+    if (_header)
     {
-        return nullptr;
+        index = _header->getIndex();
+        dataSize = _dataSize;
+        tipHash = _tipHash;
+    }
+    else if (!getIndex(*storage, index) || !getDataSize(*storage, dataSize) || !(tipHash = getTipHash(*storage)))
+    {
+        return false;
     }
 
-    return Chain::Header::unpack(value->getValue());
-}
+    Log::Ptr log;
 
-Chain::Header::Ptr Chain::getHeader(const Storage& storage) const
-{
-    const Storage::KeyValue::Ptr value = storage.get(DB_HEADER_KEY);
+    if (!openLog(*storage, log))
+    {
+        return false;
+    }
 
-    if (!value)
+    if (log && log->size() != index)
     {
-        return nullptr;
+        Logger::error("Log is out of sync (Path: {})", _logPath);
+        return false;
     }
 
-    const Chain::Header::Ptr header = Chain::Header::unpack(value->getValue());
+    const Chain::Header::Ptr header = _header ? _header : getHeader(*storage);
 
     if (!header)
     {
-        Logger::error("Can\'t parse header");
-        return nullptr;
+        return false;
     }
 
-    if (header->getVersion() != DB_VERSION)
+    Payloads payloads;
+
+    if (header->isDedup() && !getPayloads(*storage, payloads))
     {
-        Logger::error("DB version {} is not supported", header->getVersion());
-        return nullptr;
+        return false;
     }
 
-    return header;
-}
+    Refs chunkRefs;
+    Log::DataList data;
+    Storage::KeyValueList pairs;
+    Storage::KeyValueList metadata;
 
-std::string Chain::makeBlockName(const size_t index) const
-{
-    return DB_BLOCK_KEY + std::to_string(index);
+    data.reserve(blocks.size());
+    pairs.reserve(blocks.size() * 2);
+    metadata.reserve(blocks.size() + 3);
+
+    for (const Block::Ptr& block : blocks)
+    {
+        Block::Container::Ptr container = block->getData();
+
+        if (memcmp(container->getPrevHash()->data(), tipHash->data(), tipHash->length()))
+        {
+            Logger::error("Block doesn\'t continue the chain (Index: {})", index + 1);
+            return false;
+        }
+
+        if (header->isDedup() && !addPayload(*storage, container, payloads, pairs))
+        {
+            return false;
+        }
+
+        const Block::Container::ChunkList& chunks = container->getChunks();
+
+        if (!chunks.empty() && (!hasChunks(*storage, chunks) || !addChunkRefs(*storage, chunks, chunkRefs)))
+        {
+            return false;
+        }
+
+        Block::Container::Data blockData;
+
+        if (!Block::Container::pack(container, blockData))
+        {
+            Logger::error("Can\'t serialize block");
+            return false;
+        }
+
+        index++;
+        dataSize += blockData.size();
+        tipHash = container->getHash();
+
+        // Hash index entries are committed with the chain index, so they never point past the tip
+        metadata.push_back({makeHashName(container), Encoding::encodeUInt64(index)});
+
+        if (log)
+        {
+            data.push_back(std::move(blockData));
+        }
+        else
+        {
+            pairs.push_back({makeBlockName(index), blockData});
+        }
+    }
+
+    if (!storage->ingest(pairs))
+    {
+        return false;
+    }
+
+    if (header->isDedup())
+    {
+        putPayloads(payloads, metadata);
+    }
+
+    putChunkRefs(chunkRefs, metadata);
+
+    if (log && !log->append(data, true))
+    {
+        discardPairs(*storage, pairs);
+        return false;
+    }
+
+    metadata.push_back({DB_INDEX_KEY, Encoding::encodeUInt64(index)});
+    metadata.push_back({DB_SIZE_KEY, Encoding::encodeUInt64(dataSize)});
+    metadata.push_back({DB_TIP_KEY, encodeHash(tipHash)});
+
+    if (!storage->set(metadata, Storage::SYNC))
+    {
+        if (log)
+        {
+            log->truncate(index - blocks.size());
+        }
+
+        discardPairs(*storage, pairs);
+
+        return false;
+    }
+
+    if (_header)
+    {
+        _header->setIndex(index);
+        _dataSize = dataSize;
+        _tipHash = tipHash;
+    }
+
+    return true;
+}
+
+SHA256::Hash::Ptr Chain::addChunk(const std::string& data, const Storage::Durability durability) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return nullptr;
+    }
+
+    const SHA256::Hash::Ptr hash = SHA256::getHash({data});
+
+    if (!hash)
+    {
+        Logger::error("Can\'t calculate chunk hash");
+        return nullptr;
+    }
+
+    if (!storage->set({{makeChunkName(hash), data}}, durability))
+    {
+        return nullptr;
+    }
+
+    return hash;
+}
+
+bool Chain::getChunk(const SHA256::Hash::Ptr hash, std::string& data) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    Storage::Slice value;
+
+    if (!storage->get(makeChunkName(hash), value))
+    {
+        return false;
+    }
+
+    data.assign(value.getData());
+
+    return true;
+}
+
+bool Chain::hasChunks(const Block::Container::ChunkList& chunks) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    return hasChunks(*storage, chunks);
+}
+
+Block::Ptr Chain::getBlock(const size_t index) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return nullptr;
+    }
+
+    return getBlock(*storage, index);
+}
+
+Block::Ptr Chain::getBlock(const Storage& storage, const size_t index) const
+{
+    size_t lastIndex = 0;
+
+    if (!getIndex(storage, lastIndex))
+    {
+        return nullptr;
+    }
+
+    if (!index || lastIndex < index)
+    {
+        Logger::error("Invalid index {}", index);
+        return nullptr;
+    }
+
+    Log::Ptr log;
+    Archive::Ptr archive;
+
+    if (!openLog(storage, log) || !openArchive(storage, archive))
+    {
+        return nullptr;
+    }
+
+    std::string buffer;
+    Storage::Slice value;
+
+    if (log)
+    {
+        if (!log->get(index, buffer))
+        {
+            return nullptr;
+        }
+
+        value = Storage::Slice(buffer, nullptr, false);
+    }
+    else
+    {
+        bool isFound = false;
+
+        if (!storage.get(makeBlockName(index), value, isFound))
+        {
+            return nullptr;
+        }
+
+        if (!isFound && archive && index <= archive->size())
+        {
+            if (!archive->get(index, buffer))
+            {
+                return nullptr;
+            }
+
+            value = Storage::Slice(buffer, nullptr, false);
+        }
+        else if (!isFound)
+        {
+            Logger::error("Block not found (Index: {})", index);
+            return nullptr;
+        }
+    }
+
+    const Block::Container::Ptr container = unpackBlock(storage, index, value.getData());
+
+    if (!container)
+    {
+        return nullptr;
+    }
+
+    return std::make_shared<Block>(container);
+}
+
+Block::Ptr Chain::getBlockByHash(const std::string& hash) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return nullptr;
+    }
+
+    Storage::Slice value;
+
+    if (!storage->get(DB_HASH_KEY + hash, value))
+    {
+        return nullptr;
+    }
+
+    uint64_t index = 0;
+
+    if (!Encoding::decodeUInt64(value.getData(), index))
+    {
+        Logger::error("Can\'t parse block index");
+        return nullptr;
+    }
+
+    const Block::Ptr block = getBlock(*storage, index);
+
+    if (!block)
+    {
+        return nullptr;
+    }
+
+    if (encodeHash(block->getData()->getHash()) != hash)
+    {
+        Logger::error("Block not found (Index: {})", index);
+        return nullptr;
+    }
+
+    return block;
+}
+
+bool Chain::getBlocks(std::vector<Block::Ptr>& blocks) const
+{
+    size_t nextIndex = 0;
+
+    return getBlocks(1,
+        std::numeric_limits<size_t>::max(),
+        std::numeric_limits<size_t>::max(),
+        false,
+        blocks,
+        nextIndex);
+}
+
+bool Chain::getBlocks(const size_t startIndex,
+    const size_t maxCount,
+    const size_t maxBytes,
+    const bool reverse,
+    std::vector<Block::Ptr>& blocks,
+    size_t& nextIndex) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    size_t lastIndex = 0;
+
+    if (!getIndex(*storage, lastIndex))
+    {
+        return false;
+    }
+
+    nextIndex = 0;
+
+    size_t index = startIndex;
+
+    if (reverse && (!index || lastIndex < index))
+    {
+        index = lastIndex;
+    }
+    else if (!reverse && !index)
+    {
+        index = 1;
+    }
+
+    if (!index || lastIndex < index)
+    {
+        return true;
+    }
+
+    size_t count = 0;
+    size_t bytes = 0;
+
+    const auto addBlock = [&](const std::string_view value, bool& isFull)
+    {
+        if (count >= maxCount)
+        {
+            nextIndex = index;
+            isFull = true;
+            return true;
+        }
+
+        const Block::Container::Ptr container = unpackBlock(*storage, index, value);
+
+        if (!container)
+        {
+            return false;
+        }
+
+        const size_t size = container->getPayloadHash() ? value.size() + container->getData().size() : value.size();
+
+        if (count && maxBytes < bytes + size)
+        {
+            nextIndex = index;
+            isFull = true;
+            return true;
+        }
+
+        blocks.push_back(std::make_shared<Block>(container));
+
+        count++;
+        bytes += size;
+
+        index = reverse ? index - 1 : index + 1;
+
+        return true;
+    };
+
+    Log::Ptr log;
+
+    if (!openLog(*storage, log))
+    {
+        return false;
+    }
+
+    bool isFull = false;
+
+    if (log)
+    {
+        while (!isFull && index && index <= lastIndex)
+        {
+            std::string value;
+
+            if (!log->get(index, value) || !addBlock(value, isFull))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Archive::Ptr archive;
+
+    if (!openArchive(*storage, archive))
+    {
+        return false;
+    }
+
+    Storage::ReadOptions options;
+
+    options.fillCache = false;
+    options.readahead = SCAN_READAHEAD;
+
+    const Storage::Iterator::Ptr it = storage->scan(DB_BLOCK_KEY, options);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    const size_t archivedIndex = archive ? archive->size() : 0;
+
+    const auto addArchived = [&]()
+    {
+        while (!isFull && index && index <= archivedIndex)
+        {
+            std::string value;
+
+            if (!archive->get(index, value) || !addBlock(value, isFull))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    if (!reverse && !addArchived())
+    {
+        return false;
+    }
+
+    for (it->seek(makeBlockName(index)); !isFull && index > archivedIndex && index <= lastIndex; reverse ? it->prev() : it->next())
+    {
+        if (count >= maxCount)
+        {
+            nextIndex = index;
+            break;
+        }
+
+        size_t blockIndex = 0;
+
+        if (!it->isValid() || !parseBlockName(it->getKey(), blockIndex) || blockIndex != index)
+        {
+            if (it->getStatus())
+            {
+                Logger::error("Block not found (Index: {})", index);
+            }
+
+            return false;
+        }
+
+        if (!addBlock(it->getValueView(), isFull))
+        {
+            return false;
+        }
+    }
+
+    return !reverse || addArchived();
+}
+
+bool Chain::getBlocks(const std::vector<size_t>& indices, std::vector<Block::Ptr>& blocks) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    size_t lastIndex = 0;
+
+    if (!getIndex(*storage, lastIndex))
+    {
+        return false;
+    }
+
+    Log::Ptr log;
+    Archive::Ptr archive;
+
+    if (!openLog(*storage, log) || !openArchive(*storage, archive))
+    {
+        return false;
+    }
+
+    blocks.assign(indices.size(), nullptr);
+
+    const auto makeBlock = [&](const size_t index, const std::string_view value)
+    {
+        const Block::Container::Ptr container = unpackBlock(*storage, index, value);
+
+        if (!container)
+        {
+            return Block::Ptr();
+        }
+
+        return std::make_shared<Block>(container);
+    };
+
+    if (log)
+    {
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            std::string value;
+
+            if (indices[i] && indices[i] <= lastIndex && log->get(indices[i], value))
+            {
+                blocks[i] = makeBlock(indices[i], value);
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<size_t> positions;
+    Storage::KeyList keys;
+
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        if (indices[i] && indices[i] <= lastIndex)
+        {
+            positions.push_back(i);
+            keys.push_back(makeBlockName(indices[i]));
+        }
+    }
+
+    std::vector<Storage::Slice> values;
+    Storage::StatusList statuses;
+
+    if (!storage->multiGet(keys, values, statuses))
+    {
+        return false;
+    }
+
+    const size_t archivedIndex = archive ? archive->size() : 0;
+
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        const size_t index = indices[positions[i]];
+
+        if (statuses[i])
+        {
+            blocks[positions[i]] = makeBlock(index, values[i].getData());
+        }
+        else if (index <= archivedIndex)
+        {
+            std::string value;
+
+            if (archive->get(index, value))
+            {
+                blocks[positions[i]] = makeBlock(index, value);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Chain::remove() const
+{
+    if (_storage)
+    {
+        Logger::error("Chain is open (Path: {})", _path);
+        return false;
+    }
+
+    if (!Log(_logPath).remove() || !Archive(_archivePath).remove())
+    {
+        return false;
+    }
+
+    return makeStorage()->remove();
+}
+
+bool Chain::reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const
+{
+    if (_storage)
+    {
+        Logger::error("Chain is open (Path: {})", _path);
+        return false;
+    }
+
+    if (!Storage::removeFiles(_logPath, maxBytes, bytes, isDone))
+    {
+        return false;
+    }
+
+    if (isDone && !Storage::removeFiles(_archivePath, maxBytes, bytes, isDone))
+    {
+        return false;
+    }
+
+    return !isDone || makeStorage()->reclaim(maxBytes, bytes, isDone);
+}
+
+bool Chain::clone(const Chain& target) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    const Storage::Ptr targetStorage = target.makeStorage();
+
+    if (targetStorage->exists() ||
+        std::filesystem::exists(target._logPath) ||
+        std::filesystem::exists(target._archivePath))
+    {
+        Logger::error("Chain already exists (Path: {})", target._path);
+        return false;
+    }
+
+    Log::Ptr log;
+    Archive::Ptr archive;
+
+    if (!openLog(*storage, log) || !openArchive(*storage, archive))
+    {
+        return false;
+    }
+
+    if (target._database)
+    {
+        if (!targetStorage->create() || !storage->copy(*targetStorage))
+        {
+            return false;
+        }
+    }
+    else if (!storage->checkpoint(target._path))
+    {
+        return false;
+    }
+
+    if (archive && !archive->checkpoint(target._archivePath))
+    {
+        return false;
+    }
+
+    return !log || log->checkpoint(target._logPath);
+}
+
+bool Chain::setRetention(const size_t retainBlocks, const uint64_t retainAge) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const Chain::Header::Ptr header = _header ? std::make_shared<Chain::Header>(*_header) : getHeader(*storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (header->getEngine() == LOG && (retainBlocks || retainAge))
+    {
+        Logger::error("Retention isn\'t supported by log engine (Path: {})", _path);
+        return false;
+    }
+
+    header->setRetainBlocks(retainBlocks);
+    header->setRetainAge(retainAge);
+
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(header, buffer))
+    {
+        Logger::error("Can\'t serialize header");
+        return false;
+    }
+
+    if (!storage->set({{DB_HEADER_KEY, buffer}}))
+    {
+        return false;
+    }
+
+    if (_header)
+    {
+        _header->setRetainBlocks(retainBlocks);
+        _header->setRetainAge(retainAge);
+    }
+
+    return true;
+}
+
+bool Chain::prune(const uint64_t now, size_t& count) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    size_t prunedIndex = 0;
+    size_t archivedIndex = 0;
+
+    if (!getPrunedIndex(*storage, prunedIndex) || !getArchivedIndex(*storage, archivedIndex))
+    {
+        return false;
+    }
+
+    const size_t startIndex = std::max(prunedIndex, archivedIndex) + 1;
+
+    count = 0;
+
+    size_t batchCount = 0;
+
+    do
+    {
+        if (!pruneBlocks(*storage, now, PRUNE_BATCH_SIZE, batchCount))
+        {
+            return false;
+        }
+
+        count += batchCount;
+    }
+    while (batchCount == PRUNE_BATCH_SIZE);
+
+    if (!count)
+    {
+        return true;
+    }
+
+    const Chain::Header::Ptr header = _header ? getHeader() : getHeader(*storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (!storage->compact(makeBlockName(startIndex), makeBlockName(startIndex + count)))
+    {
+        return false;
+    }
+
+    return !header->isDedup() || storage->compact(DB_PAYLOAD_KEY);
+}
+
+bool Chain::archive(const size_t threshold, size_t& count) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    size_t archivedIndex = 0;
+
+    if (!getArchivedIndex(*storage, archivedIndex))
+    {
+        return false;
+    }
+
+    count = 0;
+
+    size_t rangeCount = 0;
+
+    do
+    {
+        if (!archiveBlocks(*storage, threshold, rangeCount))
+        {
+            return false;
+        }
+
+        count += rangeCount;
+    }
+    while (rangeCount);
+
+    if (!count)
+    {
+        return true;
+    }
+
+    const Chain::Header::Ptr header = _header ? getHeader() : getHeader(*storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (!storage->compact(makeBlockName(archivedIndex + 1), makeBlockName(archivedIndex + count + 1)))
+    {
+        return false;
+    }
+
+    return !header->isDedup() || storage->compact(DB_PAYLOAD_KEY);
+}
+
+bool Chain::sync() const
+{
+    if (!_storage)
+    {
+        return true;
+    }
+
+    if (_log && !_log->sync())
+    {
+        return false;
+    }
+
+    return _storage->sync();
+}
+
+Chain::Header::Ptr Chain::getHeader() const
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_header)
+        {
+            return std::make_shared<Chain::Header>(*_header);
+        }
+    }
+
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return nullptr;
+    }
+
+    return getHeader(*storage);
+}
+
+Chain::Header::Ptr Chain::getHeader(const Storage& storage) const
+{
+    Storage::Slice value;
+
+    if (!storage.get(DB_HEADER_KEY, value))
+    {
+        return nullptr;
+    }
+
+    const Chain::Header::Ptr header = Chain::Header::unpack(value.getData());
+
+    if (!header)
+    {
+        Logger::error("Can\'t parse header");
+        return nullptr;
+    }
+
+    if (header->getVersion() != DB_VERSION)
+    {
+        Logger::error("DB version {} is not supported", header->getVersion());
+        return nullptr;
+    }
+
+    size_t index = 0;
+
+    if (!getIndex(storage, index))
+    {
+        return nullptr;
+    }
+
+    header->setIndex(index);
+
+    return header;
+}
+
+bool Chain::getIndex(const Storage& storage, size_t& index) const
+{
+    Storage::Slice value;
+
+    if (!storage.get(DB_INDEX_KEY, value))
+    {
+        return false;
+    }
+
+    uint64_t data = 0;
+
+    if (!Encoding::decodeUInt64(value.getData(), data))
+    {
+        Logger::error("Can\'t parse index");
+        return false;
+    }
+
+    index = data;
+
+    return true;
+}
+
+SHA256::Hash::Ptr Chain::getTipHash() const
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_tipHash)
+        {
+            return _tipHash;
+        }
+    }
+
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return nullptr;
+    }
+
+    return getTipHash(*storage);
+}
+
+SHA256::Hash::Ptr Chain::getTipHash(const Storage& storage) const
+{
+    Storage::Slice value;
+
+    if (!storage.get(DB_TIP_KEY, value))
+    {
+        return nullptr;
+    }
+
+    const SHA256::Hash::Ptr hash = decodeHash(value.getData());
+
+    if (!hash)
+    {
+        Logger::error("Can\'t parse tip hash");
+        return nullptr;
+    }
+
+    return hash;
+}
+
+bool Chain::getPrunedIndex(size_t& index) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    return getPrunedIndex(*storage, index);
+}
+
+bool Chain::getPrunedIndex(const Storage& storage, size_t& index) const
+{
+    Storage::Slice value;
+    bool isFound = false;
+
+    if (!storage.get(DB_PRUNED_KEY, value, isFound))
+    {
+        return false;
+    }
+
+    uint64_t data = 0;
+
+    if (isFound && !Encoding::decodeUInt64(value.getData(), data))
+    {
+        Logger::error("Can\'t parse pruned index");
+        return false;
+    }
+
+    index = data;
+
+    return true;
+}
+
+bool Chain::getArchivedIndex(const Storage& storage, size_t& index) const
+{
+    Storage::Slice value;
+    bool isFound = false;
+
+    if (!storage.get(DB_ARCHIVE_KEY, value, isFound))
+    {
+        return false;
+    }
+
+    uint64_t data = 0;
+
+    if (isFound && !Encoding::decodeUInt64(value.getData(), data))
+    {
+        Logger::error("Can\'t parse archived index");
+        return false;
+    }
+
+    index = data;
+
+    return true;
+}
+
+bool Chain::getArchiveInfo(size_t& index, uint64_t& size) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    Archive::Ptr archive;
+
+    if (!getArchivedIndex(*storage, index) || !openArchive(*storage, archive))
+    {
+        return false;
+    }
+
+    size = archive ? archive->getStorageSize() : 0;
+
+    return true;
+}
+
+bool Chain::getPayloads(const Storage& storage, Payloads& payloads) const
+{
+    Storage::Slice value;
+
+    if (!storage.get(DB_DEDUP_KEY, value))
+    {
+        return false;
+    }
+
+    const std::string_view data = value.getData();
+
+    if (data.size() != sizeof(uint64_t) * 2 ||
+        !Encoding::decodeUInt64(data.substr(0, sizeof(uint64_t)), payloads.dataSize) ||
+        !Encoding::decodeUInt64(data.substr(sizeof(uint64_t)), payloads.storedSize))
+    {
+        Logger::error("Can\'t parse payload size");
+        return false;
+    }
+
+    payloads.refs.clear();
+
+    return true;
+}
+
+bool Chain::addPayload(const Storage& storage,
+    Block::Container::Ptr& container,
+    Payloads& payloads,
+    Storage::KeyValueList& pairs) const
+{
+    const Block::Container::Data data = container->getData();
+
+    if (data.size() < DEDUP_MIN_LENGTH)
+    {
+        return true;
+    }
+
+    const SHA256::Hash::Ptr hash = SHA256::getHash({data});
+
+    if (!hash)
+    {
+        Logger::error("Can\'t calculate payload hash");
+        return false;
+    }
+
+    auto it = payloads.refs.end();
+
+    if (!getRefs(storage, makeRefsName(hash), payloads.refs, it))
+    {
+        return false;
+    }
+
+    if (!it->second)
+    {
+        pairs.push_back({makePayloadName(hash), data});
+        payloads.storedSize += data.size();
+    }
+
+    it->second++;
+    payloads.dataSize += data.size();
+
+    container = std::make_shared<Block::Container>(container->getHash(),
+        container->getPrevHash(),
+        container->getNonce(),
+        Block::Container::Data(),
+        container->getSignature(),
+        container->getChunks(),
+        hash,
+        container->getTimestamp());
+
+    return true;
+}
+
+bool Chain::getRefs(const Storage& storage, const std::string& name, Refs& refs, Refs::iterator& it) const
+{
+    it = refs.find(name);
+
+    if (it != refs.end())
+    {
+        return true;
+    }
+
+    Storage::Slice value;
+    bool isFound = false;
+
+    if (!storage.get(name, value, isFound))
+    {
+        return false;
+    }
+
+    uint64_t count = 0;
+
+    if (isFound && !Encoding::decodeUInt64(value.getData(), count))
+    {
+        Logger::error("Can\'t parse references");
+        return false;
+    }
+
+    it = refs.emplace(name, count).first;
+
+    return true;
+}
+
+bool Chain::releasePayload(const Storage& storage,
+    const SHA256::Hash::Ptr hash,
+    Payloads& payloads,
+    Storage::KeyList& keys,
+    Storage::Slice& payload) const
+{
+    auto refs = payloads.refs.end();
+
+    if (!getRefs(storage, makeRefsName(hash), payloads.refs, refs) || !storage.get(makePayloadName(hash), payload))
+    {
+        Logger::error("Payload not found");
+        return false;
+    }
+
+    payloads.dataSize -= payload.getSize();
+
+    if (refs->second && !--refs->second)
+    {
+        keys.push_back(makePayloadName(hash));
+        keys.push_back(refs->first);
+
+        payloads.storedSize -= payload.getSize();
+    }
+
+    return true;
+}
+
+void Chain::putPayloads(const Payloads& payloads, Storage::KeyValueList& pairs) const
+{
+    for (const auto& [name, refs] : payloads.refs)
+    {
+        pairs.push_back({name, Encoding::encodeUInt64(refs)});
+    }
+
+    pairs.push_back({DB_DEDUP_KEY,
+        Encoding::encodeUInt64(payloads.dataSize) + Encoding::encodeUInt64(payloads.storedSize)});
+}
+
+bool Chain::hasChunks(const Storage& storage, const Block::Container::ChunkList& chunks) const
+{
+    Storage::KeyList keys;
+
+    keys.reserve(chunks.size());
+
+    for (const SHA256::Hash::Ptr& chunk : chunks)
+    {
+        keys.push_back(makeChunkName(chunk));
+    }
+
+    std::vector<Storage::Slice> values;
+    Storage::StatusList statuses;
+
+    if (!storage.multiGet(keys, values, statuses))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < statuses.size(); i++)
+    {
+        if (!statuses[i])
+        {
+            Logger::error("Chunk not found (Index: {})", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Chain::addChunkRefs(const Storage& storage, const Block::Container::ChunkList& chunks, Refs& refs) const
+{
+    for (const SHA256::Hash::Ptr& chunk : chunks)
+    {
+        auto it = refs.end();
+
+        if (!getRefs(storage, makeChunkRefsName(chunk), refs, it))
+        {
+            return false;
+        }
+
+        it->second++;
+    }
+
+    return true;
+}
+
+bool Chain::releaseChunks(const Storage& storage,
+    const Block::Container::ChunkList& chunks,
+    Refs& refs,
+    Storage::KeyList& keys) const
+{
+    for (const SHA256::Hash::Ptr& chunk : chunks)
+    {
+        auto it = refs.end();
+
+        if (!getRefs(storage, makeChunkRefsName(chunk), refs, it))
+        {
+            return false;
+        }
+
+        if (it->second && !--it->second)
+        {
+            keys.push_back(makeChunkName(chunk));
+            keys.push_back(it->first);
+        }
+    }
+
+    return true;
+}
+
+void Chain::putChunkRefs(const Refs& refs, Storage::KeyValueList& pairs) const
+{
+    for (const auto& [name, count] : refs)
+    {
+        if (count)
+        {
+            pairs.push_back({name, Encoding::encodeUInt64(count)});
+        }
+    }
+}
+
+void Chain::discardPairs(const Storage& storage, const Storage::KeyValueList& pairs) const
+{
+    Storage::KeyList keys;
+
+    keys.reserve(pairs.size());
+
+    for (const Storage::KeyValue& pair : pairs)
+    {
+        keys.push_back(pair.getKey());
+    }
+
+    if (!storage.replace(keys, {}))
+    {
+        Logger::error("Can\'t discard uncommitted blocks (Path: {})", _path);
+    }
+}
+
+bool Chain::pruneBlocks(const Storage& storage, const uint64_t now, const size_t maxCount, size_t& count) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    count = 0;
+
+    const Chain::Header::Ptr header = _header ? _header : getHeader(storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (header->getEngine() == LOG || (!header->getRetainBlocks() && !header->getRetainAge()))
+    {
+        return true;
+    }
+
+    size_t prunedIndex = 0;
+    size_t archivedIndex = 0;
+    uint64_t dataSize = 0;
+
+    if (!getPrunedIndex(storage, prunedIndex) || !getArchivedIndex(storage, archivedIndex))
+    {
+        return false;
+    }
+
+    if (_header)
+    {
+        dataSize = _dataSize;
+    }
+    else if (!getDataSize(storage, dataSize))
+    {
+        return false;
+    }
+
+    const size_t lastIndex = header->getIndex();
+    const size_t retainBlocks = header->getRetainBlocks();
+    const uint64_t retainAge = header->getRetainAge();
+
+    Payloads payloads;
+
+    if (header->isDedup() && !getPayloads(storage, payloads))
+    {
+        return false;
+    }
+
+    Storage::ReadOptions options;
+
+    options.fillCache = false;
+    options.readahead = SCAN_READAHEAD;
+
+    const Storage::Iterator::Ptr it = storage.scan(DB_BLOCK_KEY, options);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    Refs chunkRefs;
+    Storage::KeyList keys;
+    Storage::KeyValueList pairs;
+
+    size_t index = std::max(prunedIndex, archivedIndex) + 1;
+
+    for (it->seek(makeBlockName(index)); count < maxCount && index <= lastIndex; it->next())
+    {
+        size_t blockIndex = 0;
+
+        if (!it->isValid() || !parseBlockName(it->getKey(), blockIndex) || blockIndex != index)
+        {
+            if (it->getStatus())
+            {
+                Logger::error("Block not found (Index: {})", index);
+            }
+
+            return false;
+        }
+
+        const std::string_view value = it->getValueView();
+        const Block::Container::Ptr container = Block::Container::unpack(value);
+
+        if (!container)
+        {
+            Logger::error("Can\'t parse block (Index: {})", index);
+            return false;
+        }
+
+        const uint64_t timestamp = container->getTimestamp();
+
+        const bool isExpired = (retainBlocks && lastIndex - index >= retainBlocks) ||
+            (retainAge && timestamp <= now && now - timestamp >= retainAge);
+
+        if (!isExpired)
+        {
+            break;
+        }
+
+        if (container->isPruned())
+        {
+            index++;
+            count++;
+
+            continue;
+        }
+
+        SHA256::Hash::Ptr payloadHash = container->getPayloadHash();
+
+        Storage::Slice payload;
+
+        if (payloadHash)
+        {
+            if (!releasePayload(storage, payloadHash, payloads, keys, payload))
+            {
+                return false;
+            }
+        }
+        else if (!(payloadHash = SHA256::getHash({container->getData()})))
+        {
+            Logger::error("Can\'t calculate payload hash");
+            return false;
+        }
+
+        if (!releaseChunks(storage, container->getChunks(), chunkRefs, keys))
+        {
+            return false;
+        }
+
+        const Block::Container::Ptr pruned = std::make_shared<Block::Container>(container->getHash(),
+            container->getPrevHash(),
+            container->getNonce(),
+            Block::Container::Data(),
+            container->getSignature(),
+            container->getChunks(),
+            payloadHash,
+            timestamp,
+            true);
+
+        Block::Container::Data blockData;
+
+        if (!Block::Container::pack(pruned, blockData))
+        {
+            Logger::error("Can\'t serialize block");
+            return false;
+        }
+
+        dataSize = dataSize - value.size() + blockData.size();
+
+        pairs.push_back({makeBlockName(index), blockData});
+
+        index++;
+        count++;
+    }
+
+    if (!count)
+    {
+        return true;
+    }
+
+    if (header->isDedup())
+    {
+        std::erase_if(payloads.refs, [](const auto& item) { return !item.second; });
+
+        putPayloads(payloads, pairs);
+    }
+
+    putChunkRefs(chunkRefs, pairs);
+
+    pairs.push_back({DB_PRUNED_KEY, Encoding::encodeUInt64(index - 1)});
+    pairs.push_back({DB_SIZE_KEY, Encoding::encodeUInt64(dataSize)});
+
+    if (!storage.replace(keys, pairs))
+    {
+        return false;
+    }
+
+    if (_header)
+    {
+        _dataSize = dataSize;
+    }
+
+    return true;
+}
+
+bool Chain::archiveBlocks(const Storage& storage, const size_t threshold, size_t& count) const
+{
+    std::lock_guard<std::mutex> archiveLock(_archiveMutex);
+
+    count = 0;
+
+    Chain::Header::Ptr header;
+    Archive::Ptr archive;
+    size_t archivedIndex = 0;
+    size_t prunedIndex = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        header = _header ? std::make_shared<Chain::Header>(*_header) : getHeader(storage);
+
+        if (!header)
+        {
+            return false;
+        }
+
+        if (header->getEngine() == LOG)
+        {
+            return true;
+        }
+
+        if (!openArchive(storage, archive) ||
+            !getArchivedIndex(storage, archivedIndex) ||
+            !getPrunedIndex(storage, prunedIndex))
+        {
+            return false;
+        }
+
+        if (archive->size() != archivedIndex)
+        {
+            Logger::error("Archive is out of sync (Path: {})", _archivePath);
+            return false;
+        }
+    }
+
+    const size_t lastIndex = header->getIndex();
+
+    if (lastIndex < threshold || lastIndex - threshold < archivedIndex + ARCHIVE_RANGE_SIZE)
+    {
+        return true;
+    }
+
+    Storage::ReadOptions options;
+
+    options.fillCache = false;
+    options.readahead = SCAN_READAHEAD;
+
+    const Storage::Iterator::Ptr it = storage.scan(DB_BLOCK_KEY, options);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    Storage::KeyList keys;
+    Archive::DataList records;
+    std::vector<SHA256::Hash::Ptr> payloadHashes;
+    int64_t sizeDelta = 0;
+
+    size_t index = archivedIndex + 1;
+
+    for (it->seek(makeBlockName(index)); records.size() < ARCHIVE_RANGE_SIZE; it->next())
+    {
+        size_t blockIndex = 0;
+
+        if (!it->isValid() || !parseBlockName(it->getKey(), blockIndex) || blockIndex != index)
+        {
+            if (it->getStatus())
+            {
+                Logger::error("Block not found (Index: {})", index);
+            }
+
+            return false;
+        }
+
+        const std::string_view value = it->getValueView();
+        const Block::Container::Ptr container = Block::Container::unpack(value);
+
+        if (!container)
+        {
+            Logger::error("Can\'t parse block (Index: {})", index);
+            return false;
+        }
+
+        Block::Container::Data blockData(value);
+
+        if (container->getPayloadHash() && !container->isPruned())
+        {
+            Storage::Slice payload;
+
+            if (!storage.get(makePayloadName(container->getPayloadHash()), payload))
+            {
+                Logger::error("Payload not found (Index: {})", index);
+                return false;
+            }
+
+            const Block::Container::Ptr inlined = std::make_shared<Block::Container>(container->getHash(),
+                container->getPrevHash(),
+                container->getNonce(),
+                Block::Container::Data(payload.getData()),
+                container->getSignature(),
+                container->getChunks(),
+                nullptr,
+                container->getTimestamp());
+
+            if (!Block::Container::pack(inlined, blockData))
+            {
+                Logger::error("Can\'t serialize block");
+                return false;
+            }
+
+            payloadHashes.push_back(container->getPayloadHash());
+        }
+
+        sizeDelta += static_cast<int64_t>(blockData.size()) - static_cast<int64_t>(value.size());
+
+        keys.push_back(makeBlockName(index));
+        records.push_back(std::move(blockData));
+
+        index++;
+    }
+
+    std::string tmpPath;
+
+    if (!archive->prepare(archivedIndex + 1, records, tmpPath))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t currentArchivedIndex = 0;
+    size_t currentPrunedIndex = 0;
+
+    if (!getArchivedIndex(storage, currentArchivedIndex) || !getPrunedIndex(storage, currentPrunedIndex))
+    {
+        std::error_code error;
+
+        std::filesystem::remove(tmpPath, error);
+
+        return false;
+    }
+
+    // Pruning rewrites blocks in place, so a range it touched meanwhile is built again on the next pass
+    if (currentArchivedIndex != archivedIndex || currentPrunedIndex != prunedIndex)
+    {
+        std::error_code error;
+
+        std::filesystem::remove(tmpPath, error);
+
+        if (currentArchivedIndex != archivedIndex)
+        {
+            Logger::error("Archive is out of sync (Path: {})", _archivePath);
+            return false;
+        }
+
+        return true;
+    }
+
+    uint64_t dataSize = 0;
+
+    if (_header)
+    {
+        dataSize = _dataSize;
+    }
+    else if (!getDataSize(storage, dataSize))
+    {
+        return false;
+    }
+
+    Storage::KeyValueList pairs;
+
+    if (header->isDedup())
+    {
+        Payloads payloads;
+
+        if (!getPayloads(storage, payloads))
+        {
+            return false;
+        }
+
+        for (const SHA256::Hash::Ptr& payloadHash : payloadHashes)
+        {
+            Storage::Slice payload;
+
+            if (!releasePayload(storage, payloadHash, payloads, keys, payload))
+            {
+                return false;
+            }
+        }
+
+        std::erase_if(payloads.refs, [](const auto& item) { return !item.second; });
+
+        putPayloads(payloads, pairs);
+    }
+
+    dataSize += sizeDelta;
+
+    if (!archive->publish(archivedIndex + 1, tmpPath))
+    {
+        return false;
+    }
+
+    pairs.push_back({DB_ARCHIVE_KEY, Encoding::encodeUInt64(index - 1)});
+    pairs.push_back({DB_SIZE_KEY, Encoding::encodeUInt64(dataSize)});
+
+    if (!storage.replace(keys, pairs))
+    {
+        archive->truncate(archivedIndex);
+        return false;
+    }
+
+    if (_header)
+    {
+        _dataSize = dataSize;
+    }
+
+    count = records.size();
+
+    return true;
+}
+
+Block::Container::Ptr Chain::unpackBlock(const Storage& storage, const size_t index, const std::string_view value) const
+{
+    const Block::Container::Ptr container = Block::Container::unpack(value);
+
+    if (!container)
+    {
+        Logger::error("Can\'t parse block (Index: {})", index);
+        return nullptr;
+    }
+
+    if (!container->getPayloadHash() || container->isPruned())
+    {
+        return container;
+    }
+
+    Storage::Slice payload;
+
+    if (!storage.get(makePayloadName(container->getPayloadHash()), payload))
+    {
+        Logger::error("Payload not found (Index: {})", index);
+        return nullptr;
+    }
+
+    return std::make_shared<Block::Container>(container->getHash(),
+        container->getPrevHash(),
+        container->getNonce(),
+        Block::Container::Data(payload.getData()),
+        container->getSignature(),
+        container->getChunks(),
+        container->getPayloadHash(),
+        container->getTimestamp());
+}
+
+bool Chain::getDataSize(const Storage& storage, uint64_t& size) const
+{
+    Storage::Slice value;
+
+    if (!storage.get(DB_SIZE_KEY, value))
+    {
+        return false;
+    }
+
+    if (!Encoding::decodeUInt64(value.getData(), size))
+    {
+        Logger::error("Can\'t parse data size");
+        return false;
+    }
+
+    return true;
+}
+
+bool Chain::getDataSize(uint64_t& size) const
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_header)
+        {
+            size = _dataSize;
+            return true;
+        }
+    }
+
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    return getDataSize(*storage, size);
+}
+
+bool Chain::getSize(uint64_t& dataSize, uint64_t& storageSize) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    if (!getDataSize(*storage, dataSize))
+    {
+        return false;
+    }
+
+    Log::Ptr log;
+
+    if (!openLog(*storage, log))
+    {
+        return false;
+    }
+
+    if (log)
+    {
+        storageSize = log->getStorageSize();
+        return true;
+    }
+
+    if (!storage->getApproximateSize(DB_BLOCK_KEY, storageSize))
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr header = _header ? getHeader() : getHeader(*storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    uint64_t payloadSize = 0;
+
+    if (header->isDedup() && !storage->getApproximateSize(DB_PAYLOAD_KEY, payloadSize))
+    {
+        return false;
+    }
+
+    Archive::Ptr archive;
+
+    if (!openArchive(*storage, archive))
+    {
+        return false;
+    }
+
+    storageSize += payloadSize + (archive ? archive->getStorageSize() : 0);
+
+    return true;
+}
+
+bool Chain::getDedupSize(uint64_t& payloadSize, uint64_t& storedSize) const
+{
+    const Storage::Ptr storage = openStorage();
+
+    if (!storage)
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr header = _header ? getHeader() : getHeader(*storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (!header->isDedup())
+    {
+        payloadSize = 0;
+        storedSize = 0;
+
+        return true;
+    }
+
+    Payloads payloads;
+
+    if (!getPayloads(*storage, payloads))
+    {
+        return false;
+    }
+
+    payloadSize = payloads.dataSize;
+    storedSize = payloads.storedSize;
+
+    return true;
+}
+
+bool Chain::openLog(const Storage& storage, Log::Ptr& log) const
+{
+    if (_storage)
+    {
+        log = _log;
+        return true;
+    }
+
+    const Chain::Header::Ptr header = getHeader(storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (header->getEngine() != LOG)
+    {
+        log = nullptr;
+        return true;
+    }
+
+    log = std::make_shared<Log>(_logPath);
+
+    return log->open();
+}
+
+bool Chain::recoverLog(const Storage& storage, const Log::Ptr log) const
+{
+    size_t index = 0;
+
+    if (!getIndex(storage, index))
+    {
+        return false;
+    }
+
+    const size_t count = log->size();
+
+    if (count == index)
+    {
+        return true;
+    }
+
+    Logger::info("Recover log (Path: {}, Index: {}, Blocks: {})", _logPath, index, count);
+
+    if (index < count)
+    {
+        return log->truncate(index);
+    }
+
+    SHA256::Hash::Ptr tipHash;
+
+    if (count)
+    {
+        std::string value;
+
+        if (!log->get(count, value))
+        {
+            return false;
+        }
+
+        const Block::Container::Ptr container = Block::Container::unpack(value);
+
+        if (!container)
+        {
+            Logger::error("Can\'t parse block (Index: {})", count);
+            return false;
+        }
+
+        tipHash = container->getHash();
+    }
+    else
+    {
+        const Chain::Header::Ptr header = getHeader(storage);
+
+        if (!header || !(tipHash = makeGenesisHash(header)))
+        {
+            return false;
+        }
+    }
+
+    return storage.set({
+        {DB_INDEX_KEY, Encoding::encodeUInt64(count)},
+        {DB_SIZE_KEY, Encoding::encodeUInt64(log->getDataSize())},
+        {DB_TIP_KEY, encodeHash(tipHash)}});
+}
+
+bool Chain::openArchive(const Storage& storage, Archive::Ptr& archive) const
+{
+    if (_storage)
+    {
+        archive = _archive;
+        return true;
+    }
+
+    const Chain::Header::Ptr header = getHeader(storage);
+
+    if (!header)
+    {
+        return false;
+    }
+
+    if (header->getEngine() != STORAGE)
+    {
+        archive = nullptr;
+        return true;
+    }
+
+    archive = std::make_shared<Archive>(_archivePath);
+
+    return archive->open();
+}
+
+bool Chain::recoverArchive(const Storage& storage, const Archive::Ptr archive) const
+{
+    size_t index = 0;
+
+    if (!getArchivedIndex(storage, index))
+    {
+        return false;
+    }
+
+    const size_t count = archive->size();
+
+    if (count == index)
+    {
+        return true;
+    }
+
+    if (count < index)
+    {
+        Logger::error("Archive is out of sync (Path: {})", _archivePath);
+        return false;
+    }
+
+    Logger::info("Recover archive (Path: {}, Index: {}, Blocks: {})", _archivePath, index, count);
+
+    return archive->truncate(index);
+}
+
+bool Chain::upgrade(const Storage& storage) const
+{
+    const Storage::KeyValue::Ptr value = storage.get(DB_HEADER_KEY);
+
+    if (!value)
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr header = Chain::Header::unpack(value->getValue());
+
+    if (!header)
+    {
+        Logger::error("Can\'t parse header");
+        return false;
+    }
+
+    if (header->getVersion() > DB_VERSION || header->getVersion() < DB_MIN_VERSION)
+    {
+        Logger::error("DB version {} is not supported", header->getVersion());
+        return false;
+    }
+
+    size_t version = header->getVersion();
+
+    while (version < DB_VERSION)
+    {
+        Logger::info("Upgrade DB (Path: {}, Version: {} -> {})", _path, version, version + 1);
+
+        switch (version)
+        {
+        case 1:
+            if (!upgradeIndex(storage, header))
+            {
+                return false;
+            }
+            break;
+        case 2:
+            if (!upgradeBlockKeys(storage, header))
+            {
+                return false;
+            }
+            break;
+        case 3:
+            if (!upgradeDataSize(storage, header))
+            {
+                return false;
+            }
+            break;
+        case 4:
+            if (!upgradeHashIndex(storage, header))
+            {
+                return false;
+            }
+            break;
+        case 5:
+            if (!upgradeTipHash(storage, header))
+            {
+                return false;
+            }
+            break;
+        }
+
+        version++;
+    }
+
+    return true;
+}
+
+bool Chain::upgradeIndex(const Storage& storage, const Chain::Header::Ptr header) const
+{
+    const Chain::Header::Ptr upgradedHeader(new Chain::Header(2,
+        header->getData(),
+        header->getPrivateKey(),
+        header->getPublicKey()));
+
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(upgradedHeader, buffer))
+    {
+        Logger::error("Can\'t serialize header");
+        return false;
+    }
+
+    return storage.set({
+        {DB_HEADER_KEY, buffer},
+        {DB_INDEX_KEY, Encoding::encodeUInt64(header->getIndex())}});
+}
+
+bool Chain::upgradeBlockKeys(const Storage& storage, const Chain::Header::Ptr header) const
+{
+    Storage::ReadOptions options;
+
+    options.fillCache = false;
+    options.readahead = SCAN_READAHEAD;
+
+    const Storage::Iterator::Ptr it = storage.scan(DB_LEGACY_BLOCK_KEY, options);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    Storage::KeyList keys;
+    Storage::KeyValueList pairs;
+
+    for (; it->isValid(); it->next())
+    {
+        const std::string& key = it->getKey();
+        const std::string& value = key.substr(DB_LEGACY_BLOCK_KEY.size());
+
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+        {
+            Logger::error("Invalid block key (Key: {})", key);
+            return false;
+        }
+
+        keys.push_back(key);
+        pairs.push_back({makeBlockName(std::stoull(value)), it->getValue()});
+
+        if (keys.size() >= UPGRADE_BATCH_SIZE)
+        {
+            if (!storage.replace(keys, pairs))
+            {
+                return false;
+            }
+
+            keys.clear();
+            pairs.clear();
+        }
+    }
+
+    if (!it->getStatus())
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr upgradedHeader(new Chain::Header(3,
+        header->getData(),
+        header->getPrivateKey(),
+        header->getPublicKey()));
+
+    upgradedHeader->setDurability(header->getDurability());
+
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(upgradedHeader, buffer))
+    {
+        Logger::error("Can\'t serialize header");
+        return false;
+    }
+
+    pairs.push_back({DB_HEADER_KEY, buffer});
+
+    return storage.replace(keys, pairs);
+}
+
+bool Chain::upgradeDataSize(const Storage& storage, const Chain::Header::Ptr header) const
+{
+    Storage::ReadOptions options;
+
+    options.fillCache = false;
+    options.readahead = SCAN_READAHEAD;
+
+    const Storage::Iterator::Ptr it = storage.scan(DB_BLOCK_KEY, options);
+
+    if (!it)
+    {
+        return false;
+    }
+
+    uint64_t size = 0;
+
+    for (; it->isValid(); it->next())
+    {
+        size += it->getValue().size();
+    }
+
+    if (!it->getStatus())
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr upgradedHeader(new Chain::Header(4,
+        header->getData(),
+        header->getPrivateKey(),
+        header->getPublicKey()));
+
+    upgradedHeader->setDurability(header->getDurability());
+
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(upgradedHeader, buffer))
+    {
+        Logger::error("Can\'t serialize header");
+        return false;
+    }
+
+    return storage.set({
+        {DB_HEADER_KEY, buffer},
+        {DB_SIZE_KEY, Encoding::encodeUInt64(size)}});
+}
+
+bool Chain::upgradeHashIndex(const Storage& storage, const Chain::Header::Ptr header) const
+{
+    Storage::KeyValueList pairs;
+
+    const auto addHash = [this, &storage, &pairs](const size_t index, const std::string& value)
+    {
+        const Block::Container::Ptr container = Block::Container::unpack(value);
+
+        if (!container)
+        {
+            Logger::error("Can\'t parse block (Index: {})", index);
+            return false;
+        }
+
+        pairs.push_back({makeHashName(container), Encoding::encodeUInt64(index)});
+
+        if (pairs.size() >= UPGRADE_BATCH_SIZE)
+        {
+            if (!storage.set(pairs))
+            {
+                return false;
+            }
+
+            pairs.clear();
+        }
+
+        return true;
+    };
+
+    if (header->getEngine() == LOG)
+    {
+        Log log(_logPath);
+
+        size_t lastIndex = 0;
+
+        if (!getIndex(storage, lastIndex) || !log.open())
+        {
+            return false;
+        }
+
+        for (size_t index = 1; index <= std::min(lastIndex, log.size()); index++)
+        {
+            std::string value;
+
+            if (!log.get(index, value) || !addHash(index, value))
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        Storage::ReadOptions options;
+
+        options.fillCache = false;
+        options.readahead = SCAN_READAHEAD;
+
+        const Storage::Iterator::Ptr it = storage.scan(DB_BLOCK_KEY, options);
+
+        if (!it)
+        {
+            return false;
+        }
+
+        for (; it->isValid(); it->next())
+        {
+            size_t index = 0;
+
+            if (!parseBlockName(it->getKey(), index))
+            {
+                Logger::error("Invalid block key (Key: {})", it->getKey());
+                return false;
+            }
+
+            if (!addHash(index, it->getValue()))
+            {
+                return false;
+            }
+        }
+
+        if (!it->getStatus())
+        {
+            return false;
+        }
+    }
+
+    const Chain::Header::Ptr upgradedHeader(new Chain::Header(5,
+        header->getData(),
+        header->getPrivateKey(),
+        header->getPublicKey()));
+
+    upgradedHeader->setDurability(header->getDurability());
+    upgradedHeader->setEngine(header->getEngine());
+
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(upgradedHeader, buffer))
+    {
+        Logger::error("Can\'t serialize header");
+        return false;
+    }
+
+    pairs.push_back({DB_HEADER_KEY, buffer});
+
+    return storage.set(pairs);
+}
+
+bool Chain::upgradeTipHash(const Storage& storage, const Chain::Header::Ptr header) const
+{
+    size_t index = 0;
+
+    if (!getIndex(storage, index))
+    {
+        return false;
+    }
+
+    SHA256::Hash::Ptr tipHash;
+
+    if (!index)
+    {
+        tipHash = makeGenesisHash(header);
+    }
+    else
+    {
+        std::string value;
+
+        if (header->getEngine() == LOG)
+        {
+            Log log(_logPath);
+
+            if (!log.open() || !log.get(index, value))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const Storage::KeyValue::Ptr data = storage.get(makeBlockName(index));
+
+            if (!data)
+            {
+                return false;
+            }
+
+            value = data->getValue();
+        }
+
+        const Block::Container::Ptr container = Block::Container::unpack(value);
+
+        if (!container)
+        {
+            Logger::error("Can\'t parse block (Index: {})", index);
+            return false;
+        }
+
+        tipHash = container->getHash();
+    }
+
+    if (!tipHash)
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr upgradedHeader(new Chain::Header(6,
+        header->getData(),
+        header->getPrivateKey(),
+        header->getPublicKey()));
+
+    upgradedHeader->setDurability(header->getDurability());
+    upgradedHeader->setEngine(header->getEngine());
+
+    Chain::Header::Data buffer;
+
+    if (!Chain::Header::pack(upgradedHeader, buffer))
+    {
+        Logger::error("Can\'t serialize header");
+        return false;
+    }
+
+    return storage.set({
+        {DB_HEADER_KEY, buffer},
+        {DB_TIP_KEY, encodeHash(tipHash)}});
+}
+
+Storage::Ptr Chain::openStorage() const
+{
+    if (_storage)
+    {
+        return _storage;
+    }
+
+    const Storage::Ptr storage = makeStorage();
+
+    if (!storage->open())
+    {
+        return nullptr;
+    }
+
+    if (!upgrade(*storage))
+    {
+        return nullptr;
+    }
+
+    return storage;
+}
+
+Storage::Ptr Chain::makeStorage() const
+{
+    if (_database)
+    {
+        return std::make_shared<Storage>(_database, _path);
+    }
+
+    return std::make_shared<Storage>(_path, _options);
+}
+
+std::string Chain::makeBlockName(const size_t index) const
+{
+    return DB_BLOCK_KEY + Encoding::encodeUInt64(index);
+}
+
+bool Chain::parseBlockName(const std::string& name, size_t& index) const
+{
+    if (name.compare(0, DB_BLOCK_KEY.size(), DB_BLOCK_KEY))
+    {
+        return false;
+    }
+
+    uint64_t value = 0;
+
+    if (!Encoding::decodeUInt64(name.substr(DB_BLOCK_KEY.size()), value))
+    {
+        return false;
+    }
+
+    index = value;
+
+    return true;
+}
+
+std::string Chain::makeHashName(const Block::Container::Ptr container) const
+{
+    return DB_HASH_KEY + encodeHash(container->getHash());
+}
+
+std::string Chain::makeChunkName(const SHA256::Hash::Ptr hash) const
+{
+    return DB_CHUNK_KEY + encodeHash(hash);
+}
+
+std::string Chain::makePayloadName(const SHA256::Hash::Ptr hash) const
+{
+    return DB_PAYLOAD_KEY + encodeHash(hash);
+}
+
+std::string Chain::makeRefsName(const SHA256::Hash::Ptr hash) const
+{
+    return DB_REFS_KEY + encodeHash(hash);
+}
+
+std::string Chain::makeChunkRefsName(const SHA256::Hash::Ptr hash) const
+{
+    return DB_CHUNK_REFS_KEY + encodeHash(hash);
+}
+
+SHA256::Hash::Ptr Chain::makeGenesisHash(const Chain::Header::Ptr header) const
+{
+    const SHA256::Hash::Ptr hash = SHA256::getHashN({
+        header->getData(),
+        {reinterpret_cast<const char*>(header->getPrivateKey()->data()), header->getPrivateKey()->length()},
+        {reinterpret_cast<const char*>(header->getPublicKey()->data()), header->getPublicKey()->length()}
+    });
+
+    if (!hash)
+    {
+        Logger::error("Can\'t calculate header hash");
+        return nullptr;
+    }
+
+    return hash;
+}
+
+std::string Chain::encodeHash(const SHA256::Hash::Ptr hash)
+{
+    return std::string(reinterpret_cast<const char*>(hash->data()), hash->length());
+}
+
+SHA256::Hash::Ptr Chain::decodeHash(const std::string_view data)
+{
+    SHA256::Hash::Value value;
+
+    if (data.size() != sizeof(value))
+    {
+        return nullptr;
+    }
+
+    std::memcpy(value, data.data(), sizeof(value));
+
+    return std::make_shared<SHA256::Hash>(value);
 }
\ No newline at end of file
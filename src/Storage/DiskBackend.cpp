@@ -0,0 +1,511 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+#include <atomic>
+#include <filesystem>
+
+#include "Storage/DiskBackend.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+DiskBackend::Cursor::Cursor(DB::Iterator* it) :
+    _it(it)
+{
+}
+
+DiskBackend::Cursor::~Cursor()
+{
+}
+
+void DiskBackend::Cursor::seek(const std::string_view key)
+{
+    _it->Seek(DB::Slice(key.data(), key.size()));
+}
+
+void DiskBackend::Cursor::next()
+{
+    _it->Next();
+}
+
+void DiskBackend::Cursor::prev()
+{
+    _it->Prev();
+}
+
+bool DiskBackend::Cursor::isValid() const
+{
+    return _it->Valid();
+}
+
+bool DiskBackend::Cursor::getStatus() const
+{
+    const DB::Status status = _it->status();
+
+    if (!status.ok())
+    {
+        Logger::error("Iterator error ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+std::string_view DiskBackend::Cursor::getKey() const
+{
+    const DB::Slice& key = _it->key();
+
+    return std::string_view(key.data(), key.size());
+}
+
+std::string_view DiskBackend::Cursor::getValue() const
+{
+    const DB::Slice& value = _it->value();
+
+    return std::string_view(value.data(), value.size());
+}
+
+DiskBackend::DiskBackend(const std::string& path, const Storage::Options& options) :
+    _path(path),
+    _options(options),
+    _db(nullptr)
+{
+}
+
+DiskBackend::~DiskBackend()
+{
+    delete _db;
+}
+
+bool DiskBackend::create()
+{
+    DB::Options options = makeOptions();
+
+    options.create_if_missing = true;
+    options.error_if_exists = true;
+
+    const DB::Status status = DB::DB::Open(options, _path, &_db);
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t create DB ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+bool DiskBackend::open()
+{
+    const DB::Options& options = makeOptions();
+
+    const DB::Status status = DB::DB::Open(options, _path, &_db);
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t open DB ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+bool DiskBackend::close()
+{
+    delete _db;
+
+    _db = nullptr;
+
+    return true;
+}
+
+bool DiskBackend::exists() const
+{
+    std::error_code error;
+
+    return std::filesystem::exists(_path, error);
+}
+
+bool DiskBackend::get(const Storage::KeyValue::Data& key, Storage::Slice& value, bool& isFound) const
+{
+    DB::ReadOptions readOptions;
+
+    readOptions.verify_checksums = true;
+
+#ifdef USE_ROCKSDB
+    const std::shared_ptr<DB::PinnableSlice> data = std::make_shared<DB::PinnableSlice>();
+
+    const DB::Status status = _db->Get(readOptions, _db->DefaultColumnFamily(), key, data.get());
+#else
+    const std::shared_ptr<std::string> data = std::make_shared<std::string>();
+
+    const DB::Status status = _db->Get(readOptions, key, data.get());
+#endif
+
+    isFound = status.ok();
+
+    if (status.IsNotFound())
+    {
+        return true;
+    }
+
+    if (!isFound)
+    {
+        Logger::error("Can\'t get value ({})", status.ToString());
+        return false;
+    }
+
+#ifdef USE_ROCKSDB
+    value = Storage::Slice(std::string_view(data->data(), data->size()), data, data->IsPinned());
+#else
+    value = Storage::Slice(*data, data, false);
+#endif
+
+    return true;
+}
+
+bool DiskBackend::multiGet(const Storage::KeyList& keys,
+    std::vector<Storage::Slice>& values,
+    Storage::StatusList& statuses) const
+{
+    DB::ReadOptions readOptions;
+
+    readOptions.verify_checksums = true;
+
+    values.assign(keys.size(), Storage::Slice());
+    statuses.assign(keys.size(), false);
+
+#ifdef USE_ROCKSDB
+    std::vector<DB::Slice> slices(keys.begin(), keys.end());
+    std::vector<DB::Status> results(keys.size());
+
+    const std::shared_ptr<std::vector<DB::PinnableSlice>> data =
+        std::make_shared<std::vector<DB::PinnableSlice>>(keys.size());
+
+    _db->MultiGet(readOptions, _db->DefaultColumnFamily(), keys.size(), slices.data(), data->data(), results.data());
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        const DB::PinnableSlice& value = (*data)[i];
+
+        if (results[i].ok())
+        {
+            values[i] = Storage::Slice(std::string_view(value.data(), value.size()), data, value.IsPinned());
+            statuses[i] = true;
+        }
+        else if (!results[i].IsNotFound())
+        {
+            Logger::error("Can\'t get value ({})", results[i].ToString());
+            return false;
+        }
+    }
+#else
+    const DB::Snapshot* snapshot = _db->GetSnapshot();
+
+    readOptions.snapshot = snapshot;
+
+    const std::shared_ptr<std::vector<std::string>> data = std::make_shared<std::vector<std::string>>(keys.size());
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        const DB::Status status = _db->Get(readOptions, keys[i], &(*data)[i]);
+
+        if (status.ok())
+        {
+            values[i] = Storage::Slice((*data)[i], data, false);
+            statuses[i] = true;
+        }
+        else if (!status.IsNotFound())
+        {
+            _db->ReleaseSnapshot(snapshot);
+
+            Logger::error("Can\'t get value ({})", status.ToString());
+            return false;
+        }
+    }
+
+    _db->ReleaseSnapshot(snapshot);
+#endif
+
+    return true;
+}
+
+Storage::Backend::Cursor::Ptr DiskBackend::scan(const Storage::ReadOptions& options) const
+{
+    DB::ReadOptions readOptions;
+
+    readOptions.verify_checksums = true;
+    readOptions.fill_cache = options.fillCache;
+
+#ifdef USE_ROCKSDB
+    readOptions.readahead_size = options.readahead;
+#endif
+
+    return std::make_unique<Cursor>(_db->NewIterator(readOptions));
+}
+
+bool DiskBackend::write(const Storage::KeyValueList& pairs, const Storage::KeyList& keys, const bool sync) const
+{
+    DB::WriteBatch batch;
+
+    for (const Storage::KeyValue::Data& key : keys)
+    {
+        batch.Delete(key);
+    }
+
+    for (const Storage::KeyValue& pair : pairs)
+    {
+        batch.Put(pair.getKey(), pair.getValue());
+    }
+
+    DB::WriteOptions writeOptions;
+
+    writeOptions.sync = sync;
+
+    const DB::Status status = _db->Write(writeOptions, &batch);
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t set value ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+bool DiskBackend::ingest(const Storage::KeyValueList& pairs) const
+{
+    if (pairs.empty())
+    {
+        return true;
+    }
+
+#ifdef USE_ROCKSDB
+    static std::atomic<uint64_t> counter(0);
+
+    const std::string path = _path + "/ingest-" + std::to_string(counter++) + ".sst";
+
+    DB::SstFileWriter writer(DB::EnvOptions(), makeOptions());
+
+    DB::Status status = writer.Open(path);
+
+    for (size_t i = 0; status.ok() && i < pairs.size(); i++)
+    {
+        status = writer.Put(pairs[i].getKey(), pairs[i].getValue());
+    }
+
+    if (status.ok())
+    {
+        status = writer.Finish();
+    }
+
+    if (status.ok())
+    {
+        DB::IngestExternalFileOptions ingestOptions;
+
+        ingestOptions.move_files = true;
+
+        status = _db->IngestExternalFile({path}, ingestOptions);
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t ingest data ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+#else
+    return write(pairs, {}, true);
+#endif
+}
+
+bool DiskBackend::checkpoint(const std::string& path) const
+{
+#ifdef USE_ROCKSDB
+    DB::Checkpoint* checkpoint = nullptr;
+
+    DB::Status status = DB::Checkpoint::Create(_db, &checkpoint);
+
+    if (status.ok())
+    {
+        status = checkpoint->CreateCheckpoint(path);
+
+        delete checkpoint;
+    }
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t create checkpoint ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+#else
+    DiskBackend target(path, _options);
+
+    if (!target.create())
+    {
+        return false;
+    }
+
+    const bool status = copy(target, "", "");
+
+    target.close();
+
+    return status;
+#endif
+}
+
+bool DiskBackend::sync() const
+{
+#ifdef USE_ROCKSDB
+    const DB::Status status = _db->SyncWAL();
+#else
+    DB::WriteBatch batch;
+    DB::WriteOptions writeOptions;
+
+    writeOptions.sync = true;
+
+    const DB::Status status = _db->Write(writeOptions, &batch);
+#endif
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t sync DB ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+bool DiskBackend::getApproximateSize(const Storage::KeyValue::Data& start,
+    const Storage::KeyValue::Data& limit,
+    uint64_t& size) const
+{
+    const DB::Range range(start, limit);
+
+    _db->GetApproximateSizes(&range, 1, &size);
+
+    return true;
+}
+
+bool DiskBackend::reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const
+{
+    if (_db)
+    {
+        Logger::error("DB is open (Path: {})", _path);
+        return false;
+    }
+
+    return Storage::removeFiles(_path, maxBytes, bytes, isDone);
+}
+
+bool DiskBackend::compact(const Storage::KeyValue::Data& start, const Storage::KeyValue::Data& limit) const
+{
+    const DB::Slice begin(start);
+    const DB::Slice end(limit);
+
+#ifdef USE_ROCKSDB
+    const DB::Status status = _db->CompactRange(DB::CompactRangeOptions(), &begin, limit.empty() ? nullptr : &end);
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t compact DB ({})", status.ToString());
+        return false;
+    }
+#else
+    _db->CompactRange(&begin, limit.empty() ? nullptr : &end);
+#endif
+
+    return true;
+}
+
+bool DiskBackend::remove() const
+{
+    const DB::Status status = DB::DestroyDB(_path, DB::Options());
+
+    if (!status.ok())
+    {
+        Logger::error("Can\'t remove DB ({})", status.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+DB::Options DiskBackend::makeOptions() const
+{
+    DB::Options options;
+
+    options.paranoid_checks = true;
+
+    if (_options.writeBufferSize)
+    {
+        options.write_buffer_size = _options.writeBufferSize;
+    }
+
+    if (_options.maxOpenFiles)
+    {
+        options.max_open_files = _options.maxOpenFiles;
+    }
+
+#ifdef USE_ROCKSDB
+    DB::BlockBasedTableOptions tableOptions;
+
+    if (_options.blockCache)
+    {
+        tableOptions.block_cache = _options.blockCache;
+    }
+
+    tableOptions.filter_policy = _options.filterPolicy;
+
+    options.table_factory.reset(DB::NewBlockBasedTableFactory(tableOptions));
+#else
+    options.block_cache = _options.blockCache.get();
+    options.filter_policy = _options.filterPolicy.get();
+#endif
+
+    switch (_options.compression)
+    {
+    case Storage::NONE:
+        options.compression = DB::kNoCompression;
+        break;
+#ifdef USE_ROCKSDB
+    case Storage::LZ4:
+        options.compression = DB::kLZ4Compression;
+        break;
+    case Storage::ZSTD:
+        options.compression = DB::kZSTD;
+        options.compression_opts.max_dict_bytes = _options.compressionDictSize;
+        options.compression_opts.zstd_max_train_bytes = _options.compressionDictSize * 100;
+        break;
+#endif
+    default:
+        options.compression = DB::kSnappyCompression;
+        break;
+    }
+
+    return options;
+}
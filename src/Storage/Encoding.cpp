@@ -0,0 +1,101 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <zlib.h>
+
+#include "Storage/Encoding.h"
+
+using namespace Core::Storage;
+
+std::string Encoding::encodeUInt64(const uint64_t value)
+{
+    std::string data(sizeof(value), '\0');
+
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        data[i] = static_cast<char>((value >> (8 * (sizeof(value) - i - 1))) & 0xFF);
+    }
+
+    return data;
+}
+
+bool Encoding::decodeUInt64(const std::string_view data, uint64_t& value)
+{
+    if (data.size() != sizeof(value))
+    {
+        return false;
+    }
+
+    value = 0;
+
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+
+    return true;
+}
+
+uint64_t Encoding::readUInt64(const char* data)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+
+    return value;
+}
+
+void Encoding::writeUInt64(char* data, const uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        data[i] = static_cast<char>((value >> (8 * (sizeof(value) - i - 1))) & 0xFF);
+    }
+}
+
+uint32_t Encoding::readUInt32(const char* data)
+{
+    uint32_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+
+    return value;
+}
+
+void Encoding::writeUInt32(char* data, const uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        data[i] = static_cast<char>((value >> (8 * (sizeof(value) - i - 1))) & 0xFF);
+    }
+}
+
+uint32_t Encoding::crc32(const char* data, const size_t length)
+{
+    return crc32_z(0, reinterpret_cast<const Bytef*>(data), length);
+}
\ No newline at end of file
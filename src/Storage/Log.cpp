@@ -0,0 +1,1030 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+#include "Storage/Log.h"
+#include "Storage/Encoding.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+const size_t RECORD_HEADER_SIZE = 8;
+const size_t INDEX_ENTRY_SIZE = 8;
+const size_t SEAL_SIZE = 12;
+const size_t COPY_BUFFER_SIZE = 1048576;
+
+Log::Segment::Segment(const std::string& path, const size_t first) :
+    path(path),
+    first(first),
+    length(0),
+    sealed(false),
+    verified(false),
+    checksum(0),
+    dataFd(-1),
+    indexFd(-1),
+    map(nullptr),
+    mapLength(0)
+{
+}
+
+Log::Segment::~Segment()
+{
+    if (map)
+    {
+        munmap(const_cast<char*>(map), mapLength);
+    }
+
+    if (dataFd >= 0)
+    {
+        ::close(dataFd);
+    }
+
+    if (indexFd >= 0)
+    {
+        ::close(indexFd);
+    }
+}
+
+std::string Log::Segment::getDataPath() const
+{
+    return path + ".data";
+}
+
+std::string Log::Segment::getIndexPath() const
+{
+    return path + ".index";
+}
+
+std::string Log::Segment::getSealPath() const
+{
+    return path + ".seal";
+}
+
+Log::Log(const std::string& path, const size_t segmentSize) :
+    _path(path),
+    _segmentSize(segmentSize),
+    _isOpen(false),
+    _dirty(false)
+{
+}
+
+Log::~Log()
+{
+    if (_isOpen)
+    {
+        close();
+    }
+}
+
+bool Log::create()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_isOpen)
+    {
+        Logger::error("Log already open (Path: {})", _path);
+        return false;
+    }
+
+    std::error_code error;
+
+    if (!std::filesystem::create_directory(_path, error))
+    {
+        Logger::error("Can\'t create log (Path: {})", _path);
+        return false;
+    }
+
+    _isOpen = true;
+
+    return true;
+}
+
+bool Log::open()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_isOpen)
+    {
+        Logger::error("Log already open (Path: {})", _path);
+        return false;
+    }
+
+    std::error_code error;
+
+    std::filesystem::directory_iterator it(_path, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t open log ({})", error.message());
+        return false;
+    }
+
+    std::vector<size_t> firsts;
+
+    for (const std::filesystem::directory_entry& entry : it)
+    {
+        if (entry.path().extension() != ".data")
+        {
+            continue;
+        }
+
+        const std::string& name = entry.path().stem().string();
+
+        if (name.empty() || name.find_first_not_of("0123456789") != std::string::npos)
+        {
+            Logger::error("Invalid segment (Path: {})", entry.path().string());
+            return false;
+        }
+
+        firsts.push_back(std::stoull(name));
+    }
+
+    std::sort(firsts.begin(), firsts.end());
+
+    std::vector<Segment::Ptr> segments;
+
+    for (const size_t first : firsts)
+    {
+        const Segment::Ptr segment = load(first);
+
+        if (!segment)
+        {
+            return false;
+        }
+
+        const size_t expected = segments.empty() ? 1 : segments.back()->first + segments.back()->offsets.size();
+
+        if (segment->first != expected || (!segments.empty() && !segments.back()->sealed))
+        {
+            Logger::error("Invalid segment sequence (Path: {})", segment->path);
+            return false;
+        }
+
+        segments.push_back(segment);
+    }
+
+    if (!segments.empty() && !segments.back()->sealed)
+    {
+        if (!recover(segments.back()) || !activate(segments.back()))
+        {
+            return false;
+        }
+    }
+
+    _segments = segments;
+    _isOpen = true;
+
+    return true;
+}
+
+bool Log::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Log is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (_dirty && !_segments.empty() && !_segments.back()->sealed)
+    {
+        fdatasync(_segments.back()->dataFd);
+        fdatasync(_segments.back()->indexFd);
+    }
+
+    _segments.clear();
+    _isOpen = false;
+    _dirty = false;
+
+    return true;
+}
+
+bool Log::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _isOpen;
+}
+
+bool Log::append(const DataList& records, const bool sync)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Log is not open (Path: {})", _path);
+        return false;
+    }
+
+    Segment::Ptr segment = (_segments.empty() || _segments.back()->sealed) ? nullptr : _segments.back();
+
+    for (const Data& record : records)
+    {
+        const size_t recordSize = RECORD_HEADER_SIZE + record.size();
+
+        if (segment && segment->length && _segmentSize < segment->length + recordSize)
+        {
+            if (!seal(segment))
+            {
+                return false;
+            }
+
+            segment = nullptr;
+        }
+
+        if (!segment)
+        {
+            segment = make(getCount() + 1);
+
+            if (!segment)
+            {
+                return false;
+            }
+
+            _segments.push_back(segment);
+        }
+
+        std::string buffer(RECORD_HEADER_SIZE, '\0');
+
+        Encoding::writeUInt32(&buffer[0], record.size());
+        Encoding::writeUInt32(&buffer[4], Encoding::crc32(record.data(), record.size()));
+
+        buffer.append(record);
+
+        const std::string& entry = Encoding::encodeUInt64(segment->length);
+
+        if (!write(segment->dataFd, segment->length, buffer.data(), buffer.size()) ||
+            !write(segment->indexFd, segment->offsets.size() * INDEX_ENTRY_SIZE, entry.data(), entry.size()))
+        {
+            return false;
+        }
+
+        segment->offsets.push_back(segment->length);
+        segment->length += buffer.size();
+    }
+
+    if (!segment)
+    {
+        return true;
+    }
+
+    if (sync)
+    {
+        if (fdatasync(segment->dataFd) || fdatasync(segment->indexFd))
+        {
+            Logger::error("Can\'t sync log ({})", strerror(errno));
+            return false;
+        }
+    }
+    else
+    {
+        _dirty = true;
+    }
+
+    return true;
+}
+
+bool Log::get(const size_t index, Data& data) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Log is not open (Path: {})", _path);
+        return false;
+    }
+
+    const Segment::Ptr segment = find(index);
+
+    if (!segment)
+    {
+        Logger::error("Invalid log index {}", index);
+        return false;
+    }
+
+    const size_t position = index - segment->first;
+
+    const uint64_t offset = segment->offsets[position];
+    const uint64_t end = position + 1 < segment->offsets.size() ? segment->offsets[position + 1] : segment->length;
+
+    if (!map(segment, segment->sealed ? segment->length : std::max<uint64_t>(_segmentSize, segment->length)))
+    {
+        return false;
+    }
+
+    const char* record = segment->map + offset;
+
+    const uint32_t length = Encoding::readUInt32(record);
+
+    if (end < offset + RECORD_HEADER_SIZE || offset + RECORD_HEADER_SIZE + length != end ||
+        Encoding::readUInt32(record + 4) != Encoding::crc32(record + RECORD_HEADER_SIZE, length))
+    {
+        Logger::error("Corrupted log record (Path: {}, Index: {})", segment->path, index);
+        return false;
+    }
+
+    data.assign(record + RECORD_HEADER_SIZE, length);
+
+    return true;
+}
+
+bool Log::truncate(const size_t count)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Log is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (getCount() < count)
+    {
+        Logger::error("Can\'t truncate log beyond its end (Count: {})", count);
+        return false;
+    }
+
+    std::error_code error;
+
+    while (!_segments.empty() && count < _segments.back()->first)
+    {
+        const Segment::Ptr segment = _segments.back();
+
+        _segments.pop_back();
+
+        std::filesystem::remove(segment->getSealPath(), error);
+        std::filesystem::remove(segment->getIndexPath(), error);
+
+        if (!std::filesystem::remove(segment->getDataPath(), error))
+        {
+            Logger::error("Can\'t remove segment (Path: {})", segment->path);
+            return false;
+        }
+    }
+
+    if (_segments.empty())
+    {
+        return true;
+    }
+
+    const Segment::Ptr segment = _segments.back();
+
+    const size_t keep = count - segment->first + 1;
+
+    if (keep == segment->offsets.size())
+    {
+        return true;
+    }
+
+    unmap(segment);
+
+    if (!detach(segment))
+    {
+        return false;
+    }
+
+    segment->length = segment->offsets[keep];
+    segment->offsets.resize(keep);
+
+    if (segment->sealed)
+    {
+        std::filesystem::remove(segment->getSealPath(), error);
+
+        segment->sealed = false;
+    }
+
+    std::filesystem::resize_file(segment->getDataPath(), segment->length, error);
+
+    if (!error)
+    {
+        std::filesystem::resize_file(segment->getIndexPath(), keep * INDEX_ENTRY_SIZE, error);
+    }
+
+    if (error)
+    {
+        Logger::error("Can\'t truncate segment ({})", error.message());
+        return false;
+    }
+
+    return segment->dataFd >= 0 || activate(segment);
+}
+
+bool Log::sync()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_isOpen)
+    {
+        Logger::error("Log is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (!_dirty)
+    {
+        return true;
+    }
+
+    if (!_segments.empty() && !_segments.back()->sealed)
+    {
+        if (fdatasync(_segments.back()->dataFd) || fdatasync(_segments.back()->indexFd))
+        {
+            Logger::error("Can\'t sync log ({})", strerror(errno));
+            return false;
+        }
+    }
+
+    _dirty = false;
+
+    return true;
+}
+
+bool Log::remove() const
+{
+    std::error_code error;
+
+    std::filesystem::remove_all(_path, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t remove log ({})", error.message());
+        return false;
+    }
+
+    return true;
+}
+
+bool Log::checkpoint(const std::string& path) const
+{
+    struct Snapshot
+    {
+        std::string path;
+        uint64_t length;
+        size_t count;
+        bool sealed;
+    };
+
+    std::vector<Snapshot> snapshots;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (!_isOpen)
+        {
+            Logger::error("Log is not open (Path: {})", _path);
+            return false;
+        }
+
+        for (const Segment::Ptr& segment : _segments)
+        {
+            snapshots.push_back({segment->path, segment->length, segment->offsets.size(), segment->sealed});
+        }
+    }
+
+    std::error_code error;
+
+    if (!std::filesystem::create_directory(path, error))
+    {
+        Logger::error("Can\'t create log (Path: {})", path);
+        return false;
+    }
+
+    for (const Snapshot& snapshot : snapshots)
+    {
+        const Segment source(snapshot.path, 0);
+        const Segment target(std::filesystem::path(path) / std::filesystem::path(snapshot.path).filename(), 0);
+
+        if (snapshot.sealed)
+        {
+            std::filesystem::create_hard_link(source.getDataPath(), target.getDataPath(), error);
+
+            if (!error)
+            {
+                std::filesystem::create_hard_link(source.getIndexPath(), target.getIndexPath(), error);
+            }
+
+            if (!error)
+            {
+                std::filesystem::create_hard_link(source.getSealPath(), target.getSealPath(), error);
+            }
+
+            if (!error)
+            {
+                continue;
+            }
+
+            Logger::info("Can\'t link segment, copy it instead ({})", error.message());
+
+            error.clear();
+
+            std::filesystem::remove(target.getDataPath(), error);
+            std::filesystem::remove(target.getIndexPath(), error);
+            std::filesystem::remove(target.getSealPath(), error);
+
+            if (!std::filesystem::copy_file(source.getSealPath(), target.getSealPath(), error))
+            {
+                Logger::error("Can\'t copy segment ({})", error.message());
+                return false;
+            }
+        }
+
+        if (!copyFile(source.getDataPath(), target.getDataPath(), snapshot.length) ||
+            !copyFile(source.getIndexPath(), target.getIndexPath(), snapshot.count * INDEX_ENTRY_SIZE))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t Log::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return getCount();
+}
+
+uint64_t Log::getDataSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t size = 0;
+
+    for (const Segment::Ptr& segment : _segments)
+    {
+        size += segment->length - segment->offsets.size() * RECORD_HEADER_SIZE;
+    }
+
+    return size;
+}
+
+uint64_t Log::getStorageSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t size = 0;
+
+    for (const Segment::Ptr& segment : _segments)
+    {
+        size += segment->length + segment->offsets.size() * INDEX_ENTRY_SIZE;
+    }
+
+    return size;
+}
+
+Log::Segment::Ptr Log::load(const size_t first) const
+{
+    const Segment::Ptr segment = std::make_shared<Segment>(makeSegmentPath(first), first);
+
+    std::error_code error;
+
+    segment->length = std::filesystem::file_size(segment->getDataPath(), error);
+
+    if (error)
+    {
+        Logger::error("Can\'t read segment ({})", error.message());
+        return nullptr;
+    }
+
+    std::string index;
+
+    if (!readFile(segment->getIndexPath(), index))
+    {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i + INDEX_ENTRY_SIZE <= index.size(); i += INDEX_ENTRY_SIZE)
+    {
+        segment->offsets.push_back(Encoding::readUInt64(&index[i]));
+    }
+
+    if (!std::filesystem::exists(segment->getSealPath()))
+    {
+        return segment;
+    }
+
+    std::string seal;
+
+    if (!readFile(segment->getSealPath(), seal))
+    {
+        return nullptr;
+    }
+
+    const uint64_t count = seal.size() == SEAL_SIZE ? Encoding::readUInt64(&seal[0]) : 0;
+
+    if (!count || segment->offsets.size() < count)
+    {
+        Logger::error("Invalid segment seal (Path: {})", segment->path);
+        return nullptr;
+    }
+
+    segment->offsets.resize(count);
+    segment->checksum = Encoding::readUInt32(&seal[8]);
+    segment->sealed = true;
+
+    return segment;
+}
+
+Log::Segment::Ptr Log::make(const size_t first) const
+{
+    const Segment::Ptr segment = std::make_shared<Segment>(makeSegmentPath(first), first);
+
+    if (!activate(segment))
+    {
+        return nullptr;
+    }
+
+    return segment;
+}
+
+bool Log::recover(const Segment::Ptr segment) const
+{
+    if (!map(segment, segment->length))
+    {
+        return false;
+    }
+
+    size_t count = 0;
+    uint64_t end = 0;
+
+    for (; count < segment->offsets.size(); count++)
+    {
+        const uint64_t offset = segment->offsets[count];
+
+        if (offset != end || segment->length < offset + RECORD_HEADER_SIZE)
+        {
+            break;
+        }
+
+        const char* record = segment->map + offset;
+
+        const uint32_t length = Encoding::readUInt32(record);
+
+        if (segment->length < offset + RECORD_HEADER_SIZE + length ||
+            Encoding::readUInt32(record + 4) != Encoding::crc32(record + RECORD_HEADER_SIZE, length))
+        {
+            break;
+        }
+
+        end = offset + RECORD_HEADER_SIZE + length;
+    }
+
+    unmap(segment);
+
+    if (count == segment->offsets.size() && end == segment->length)
+    {
+        return true;
+    }
+
+    Logger::info("Recover segment (Path: {}, Records: {} -> {})", segment->path, segment->offsets.size(), count);
+
+    segment->offsets.resize(count);
+    segment->length = end;
+
+    std::error_code error;
+
+    std::filesystem::resize_file(segment->getDataPath(), segment->length, error);
+
+    if (!error)
+    {
+        std::filesystem::resize_file(segment->getIndexPath(), count * INDEX_ENTRY_SIZE, error);
+    }
+
+    if (error)
+    {
+        Logger::error("Can\'t recover segment ({})", error.message());
+        return false;
+    }
+
+    return true;
+}
+
+bool Log::seal(const Segment::Ptr segment) const
+{
+    if (fdatasync(segment->dataFd) || fdatasync(segment->indexFd))
+    {
+        Logger::error("Can\'t sync segment ({})", strerror(errno));
+        return false;
+    }
+
+    unmap(segment);
+
+    if (!map(segment, segment->length))
+    {
+        return false;
+    }
+
+    segment->checksum = Encoding::crc32(segment->map, segment->length);
+
+    std::string seal = Encoding::encodeUInt64(segment->offsets.size());
+
+    seal.resize(SEAL_SIZE);
+
+    Encoding::writeUInt32(&seal[8], segment->checksum);
+
+    const std::string& path = segment->getSealPath() + ".tmp";
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t create seal ({})", strerror(errno));
+        return false;
+    }
+
+    const bool status = write(fd, 0, seal.data(), seal.size()) && !fsync(fd);
+
+    ::close(fd);
+
+    if (!status || std::rename(path.c_str(), segment->getSealPath().c_str()))
+    {
+        Logger::error("Can\'t write seal (Path: {})", segment->path);
+        return false;
+    }
+
+    ::close(segment->dataFd);
+    ::close(segment->indexFd);
+
+    segment->dataFd = -1;
+    segment->indexFd = -1;
+
+    segment->sealed = true;
+    segment->verified = true;
+
+    return true;
+}
+
+bool Log::activate(const Segment::Ptr segment) const
+{
+    segment->dataFd = ::open(segment->getDataPath().c_str(), O_WRONLY | O_CREAT, 0644);
+    segment->indexFd = ::open(segment->getIndexPath().c_str(), O_WRONLY | O_CREAT, 0644);
+
+    if (segment->dataFd < 0 || segment->indexFd < 0)
+    {
+        Logger::error("Can\'t open segment ({})", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool Log::map(const Segment::Ptr segment, const uint64_t length) const
+{
+    if (segment->map && length <= segment->mapLength)
+    {
+        return true;
+    }
+
+    unmap(segment);
+
+    if (!length)
+    {
+        return true;
+    }
+
+    const int fd = ::open(segment->getDataPath().c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t open segment ({})", strerror(errno));
+        return false;
+    }
+
+    void* data = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        Logger::error("Can\'t map segment ({})", strerror(errno));
+        return false;
+    }
+
+    segment->map = static_cast<const char*>(data);
+    segment->mapLength = length;
+
+    if (segment->sealed && !segment->verified)
+    {
+        if (Encoding::crc32(segment->map, segment->length) != segment->checksum)
+        {
+            Logger::error("Segment checksum mismatch (Path: {})", segment->path);
+
+            unmap(segment);
+
+            return false;
+        }
+
+        segment->verified = true;
+    }
+
+    return true;
+}
+
+void Log::unmap(const Segment::Ptr segment) const
+{
+    if (!segment->map)
+    {
+        return;
+    }
+
+    munmap(const_cast<char*>(segment->map), segment->mapLength);
+
+    segment->map = nullptr;
+    segment->mapLength = 0;
+}
+
+bool Log::write(const int fd, const uint64_t offset, const char* data, const size_t length) const
+{
+    size_t written = 0;
+
+    while (written < length)
+    {
+        const ssize_t result = pwrite(fd, data + written, length - written, offset + written);
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            Logger::error("Can\'t write log ({})", strerror(errno));
+            return false;
+        }
+
+        written += result;
+    }
+
+    return true;
+}
+
+bool Log::readFile(const std::string& path, std::string& data) const
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+    {
+        Logger::error("Can\'t read file (Path: {})", path);
+        return false;
+    }
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return true;
+}
+
+bool Log::copyFile(const std::string& from, const std::string& to, const uint64_t length) const
+{
+    std::ifstream file(from, std::ios::binary);
+
+    if (!file)
+    {
+        Logger::error("Can\'t read file (Path: {})", from);
+        return false;
+    }
+
+    const int fd = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        Logger::error("Can\'t create file ({})", strerror(errno));
+        return false;
+    }
+
+    std::vector<char> buffer(COPY_BUFFER_SIZE);
+    uint64_t offset = 0;
+
+    while (offset < length)
+    {
+        const size_t size = std::min<uint64_t>(buffer.size(), length - offset);
+
+        if (!file.read(buffer.data(), size) || !write(fd, offset, buffer.data(), size))
+        {
+            Logger::error("Can\'t copy file (Path: {})", from);
+
+            ::close(fd);
+            return false;
+        }
+
+        offset += size;
+    }
+
+    const bool status = !fsync(fd);
+
+    ::close(fd);
+
+    return status;
+}
+
+bool Log::detach(const Segment::Ptr segment) const
+{
+    std::error_code error;
+    bool isDetached = false;
+
+    for (const std::string& path : {segment->getDataPath(), segment->getIndexPath()})
+    {
+        const uintmax_t count = std::filesystem::hard_link_count(path, error);
+
+        if (error || count <= 1)
+        {
+            error.clear();
+            continue;
+        }
+
+        const std::string& tmpPath = path + ".tmp";
+
+        std::filesystem::copy_file(path, tmpPath, std::filesystem::copy_options::overwrite_existing, error);
+
+        if (!error)
+        {
+            std::filesystem::rename(tmpPath, path, error);
+        }
+
+        if (error)
+        {
+            Logger::error("Can\'t detach segment ({})", error.message());
+            return false;
+        }
+
+        isDetached = true;
+    }
+
+    if (!isDetached || segment->dataFd < 0)
+    {
+        return true;
+    }
+
+    ::close(segment->dataFd);
+    ::close(segment->indexFd);
+
+    return activate(segment);
+}
+
+Log::Segment::Ptr Log::find(const size_t index) const
+{
+    const auto it = std::upper_bound(_segments.begin(), _segments.end(), index,
+        [](const size_t value, const Segment::Ptr& segment) {
+            return value < segment->first;
+        });
+
+    if (it == _segments.begin())
+    {
+        return nullptr;
+    }
+
+    const Segment::Ptr segment = *std::prev(it);
+
+    if (segment->offsets.size() <= index - segment->first)
+    {
+        return nullptr;
+    }
+
+    return segment;
+}
+
+size_t Log::getCount() const
+{
+    if (_segments.empty())
+    {
+        return 0;
+    }
+
+    return _segments.back()->first + _segments.back()->offsets.size() - 1;
+}
+
+std::string Log::makeSegmentPath(const size_t first) const
+{
+    std::string name = std::to_string(first);
+
+    name.insert(0, 20 - name.size(), '0');
+
+    return std::filesystem::path(_path) / name;
+}
@@ -20,92 +20,813 @@
    SOFTWARE.
 */
 
+#include <chrono>
+#include <charconv>
 #include <filesystem>
 
 #include "System/Logger.h"
 #include "Storage/Manager.h"
+#include "Storage/Protocol.h"
 
 using namespace Core::Storage;
 using namespace Core::Crypto;
 
-Manager::Manager(const std::string& storageDir) :
-    _storageDir(storageDir)
+const std::string SHARED_STORAGE_NAME = "chains.db";
+const std::string CATALOG_STORAGE_NAME = "catalog.db";
+const std::string BACKUP_DIR_NAME = "backups";
+
+Manager::Manager(const std::string& storageDir,
+    const size_t cacheSize,
+    const size_t cacheTimeout,
+    const Storage::Options& options,
+    const Layout layout) :
+    _storageDir(storageDir),
+    _backupDir(options.backupDir.empty() ? (std::filesystem::path(storageDir) / BACKUP_DIR_NAME).string() : options.backupDir),
+    _options(options),
+    _layout(layout),
+    _cache(cacheSize, cacheTimeout, [this](const Cache::ChainList& chains) { updateCatalogEntries(chains); }),
+    _syncer(_cache, options.syncInterval),
+    _pruner(_cache, options.pruneInterval, options.archiveThreshold)
 {
+    if (!_options.blockCache)
+    {
+        _options.blockCache = Storage::makeBlockCache(_options.blockCacheSize);
+    }
+
+    if (!_options.filterPolicy)
+    {
+        _options.filterPolicy = Storage::makeFilterPolicy(_options.bloomBitsPerKey);
+    }
+
+    if (_layout == SHARED)
+    {
+        const std::string& path = std::filesystem::path(_storageDir) / SHARED_STORAGE_NAME;
+
+        const Storage::Ptr database = std::make_shared<Storage>(path, _options);
+
+        if (database->exists() ? database->open() : database->create())
+        {
+            _database = database;
+        }
+        else
+        {
+            Logger::error("Can\'t open shared storage (Path: {})", path);
+        }
+    }
+
+    const std::string& catalogPath = std::filesystem::path(_storageDir) / CATALOG_STORAGE_NAME;
+
+    const Catalog::Ptr catalog = std::make_shared<Catalog>(catalogPath, _options);
+    const bool isCreated = !catalog->exists();
+
+    if (std::filesystem::is_directory(_storageDir) && (isCreated ? catalog->create() : catalog->open()))
+    {
+        _catalog = catalog;
+
+        _reclaimer = std::make_shared<Reclaimer>(*catalog,
+            [this](const size_t chainId) { return makeChain(chainId); },
+            _options.reclaimInterval,
+            _options.reclaimRate,
+            [this](const size_t chainId) { return _cache.isInUse(chainId); });
+
+        if (isCreated && !rebuildCatalog())
+        {
+            Logger::error("Can\'t rebuild chain catalog (Path: {})", catalogPath);
+        }
+    }
+    else
+    {
+        Logger::error("Can\'t open chain catalog (Path: {})", catalogPath);
+    }
+
+    _syncer.start();
+    _pruner.start();
+
+    if (_reclaimer)
+    {
+        _reclaimer->start();
+    }
+}
+
+Manager::~Manager()
+{
+    _syncer.stop();
+    _pruner.stop();
+
+    if (_reclaimer)
+    {
+        _reclaimer->stop();
+    }
+
+    _cache.clear();
+}
+
+Chain::Ptr Manager::createChain(const size_t chainId,
+    const std::string& data,
+    const Storage::Durability durability,
+    const Chain::Engine engine,
+    const bool dedup) const
+{
+    const Crypto::Secp256k1::PrivateKey::Ptr privateKey = _secp256k1.generatePrivateKey();
+
+    if (!privateKey)
+    {
+        Logger::error("Can\'t generate private key");
+        return nullptr;
+    }
+
+    const Crypto::Secp256k1::PublicKey::Ptr publicKey = _secp256k1.createPublicKey(privateKey);
+
+    if (!publicKey)
+    {
+        Logger::error("Can\'t create public key");
+        return nullptr;
+    }
+
+    if (!_catalog)
+    {
+        Logger::error("Chain catalog is not open");
+        return nullptr;
+    }
+
+    if (_catalog->hasChain(chainId))
+    {
+        Logger::error("Chain already exists (Chain ID: {})", chainId);
+        return nullptr;
+    }
+
+    if (!reclaimChain(chainId))
+    {
+        return nullptr;
+    }
+
+    const Chain::Ptr chain = makeChain(chainId);
+
+    if (!chain || !chain->create(data, privateKey, publicKey, durability, engine, dedup))
+    {
+        return nullptr;
+    }
+
+    const uint64_t createdAt = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    if (!addCatalogEntry(chainId, *chain, createdAt))
+    {
+        return nullptr;
+    }
+
+    return chain;
+}
+
+Block::Ptr Manager::addBlock(const size_t chainId,
+    const std::string& data,
+    const Storage::Durability durability,
+    const Block::Container::ChunkList& chunks) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return nullptr;
+    }
+
+    const Chain::Header::Ptr header = chain->getHeader();
+
+    if (!header)
+    {
+        Logger::error("Can\'t get header");
+        return nullptr;
+    }
+
+    if (!chunks.empty() && !chain->hasChunks(chunks))
+    {
+        Logger::error("Can\'t add block (Missing chunks)");
+        return nullptr;
+    }
+
+    const auto builder = [&](const SHA256::Hash::Ptr prevHash)
+    {
+        return makeBlock(header, prevHash, data, chunks);
+    };
+
+    const Block::Ptr block = chain->addBlock(builder, durability == Storage::DEFAULT ? header->getDurability() : durability);
+
+    if (!block)
+    {
+        Logger::error("Can\'t add block");
+        return nullptr;
+    }
+
+    return block;
+}
+
+SHA256::Hash::Ptr Manager::addChunk(const size_t chainId, const std::string& data) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return nullptr;
+    }
+
+    const Chain::Header::Ptr header = chain->getHeader();
+
+    if (!header)
+    {
+        Logger::error("Can\'t get header");
+        return nullptr;
+    }
+
+    return chain->addChunk(data, header->getDurability());
+}
+
+bool Manager::getChunk(const size_t chainId, const SHA256::Hash::Ptr hash, std::string& data) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    return chain->getChunk(hash, data);
+}
+
+bool Manager::importBlocks(const size_t chainId, const std::vector<std::string>& payloads, size_t& index) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr header = chain->getHeader();
+
+    if (!header)
+    {
+        Logger::error("Can\'t get header");
+        return false;
+    }
+
+    SHA256::Hash::Ptr prevHash = chain->getTipHash();
+
+    if (!prevHash)
+    {
+        Logger::error("Can\'t get tip hash");
+        return false;
+    }
+
+    BlockList blocks;
+
+    blocks.reserve(payloads.size());
+
+    for (const std::string& data : payloads)
+    {
+        const Block::Ptr block = makeBlock(header, prevHash, data);
+
+        if (!block)
+        {
+            return false;
+        }
+
+        blocks.push_back(block);
+
+        prevHash = block->getData()->getHash();
+    }
+
+    if (!chain->importBlocks(blocks))
+    {
+        Logger::error("Can\'t import blocks");
+        return false;
+    }
+
+    const Chain::Header::Ptr result = chain->getHeader();
+
+    if (!result)
+    {
+        Logger::error("Can\'t get header");
+        return false;
+    }
+
+    index = result->getIndex();
+
+    return true;
+}
+
+Block::Ptr Manager::getBlock(const size_t chainId, const size_t index) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return nullptr;
+    }
+
+    return chain->getBlock(index);
+}
+
+Block::Ptr Manager::getBlockByHash(const size_t chainId, const std::string& hash) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return nullptr;
+    }
+
+    return chain->getBlockByHash(hash);
+}
+
+bool Manager::getBlocks(const size_t chainId, BlockList& blocks) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    return chain->getBlocks(blocks);
+}
+
+bool Manager::getBlocks(const size_t chainId,
+    const size_t startIndex,
+    const size_t maxCount,
+    const size_t maxBytes,
+    const bool reverse,
+    BlockList& blocks,
+    size_t& nextIndex) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    return chain->getBlocks(startIndex, maxCount, maxBytes, reverse, blocks, nextIndex);
+}
+
+bool Manager::getBlocksByIndex(const BlockIndexList& items, BlockList& blocks) const
+{
+    std::map<size_t, std::vector<size_t>> positions;
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        positions[items[i].chainId].push_back(i);
+    }
+
+    blocks.assign(items.size(), nullptr);
+
+    for (const auto& [chainId, list] : positions)
+    {
+        const Chain::Ptr chain = getChain(chainId);
+
+        if (!chain)
+        {
+            continue;
+        }
+
+        std::vector<size_t> indices;
+        BlockList result;
+
+        indices.reserve(list.size());
+
+        for (const size_t position : list)
+        {
+            indices.push_back(items[position].index);
+        }
+
+        if (!chain->getBlocks(indices, result))
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            blocks[list[i]] = result[i];
+        }
+    }
+
+    return true;
+}
+
+bool Manager::removeChain(const size_t chainId) const
+{
+    if (!_catalog)
+    {
+        Logger::error("Chain catalog is not open");
+        return false;
+    }
+
+    _cache.remove(chainId);
+
+    return _catalog->removeChain(chainId);
+}
+
+bool Manager::hasChain(const size_t chainId) const
+{
+    if (!_catalog)
+    {
+        Logger::error("Chain catalog is not open");
+        return false;
+    }
+
+    return _catalog->hasChain(chainId);
+}
+
+bool Manager::getReclaimStats(Reclaimer::Stats& stats) const
+{
+    if (!_reclaimer)
+    {
+        Logger::error("Chain catalog is not open");
+        return false;
+    }
+
+    return _reclaimer->getStats(stats);
+}
+
+bool Manager::listChains(const size_t startId,
+    const size_t maxCount,
+    Catalog::EntryList& entries,
+    size_t& nextId) const
+{
+    if (!_catalog)
+    {
+        Logger::error("Chain catalog is not open");
+        return false;
+    }
+
+    const size_t first = entries.size();
+
+    if (!_catalog->getChains(startId, maxCount, entries, nextId))
+    {
+        return false;
+    }
+
+    // The catalog is refreshed when chains leave the cache, open chains report their live state
+    for (size_t i = first; i < entries.size(); i++)
+    {
+        const Chain::Ptr chain = _cache.find(entries[i].chainId);
+
+        if (!chain)
+        {
+            continue;
+        }
+
+        const Chain::Header::Ptr header = chain->getHeader();
+        uint64_t dataSize = 0;
+
+        if (!header || !chain->getDataSize(dataSize))
+        {
+            Logger::error("Can\'t get chain state (Chain ID: {})", entries[i].chainId);
+            return false;
+        }
+
+        entries[i].index = header->getIndex();
+        entries[i].dataSize = dataSize;
+    }
+
+    return true;
+}
+
+bool Manager::backupChain(const size_t chainId, const std::string& path) const
+{
+    const std::filesystem::path& relativePath = std::filesystem::path(path).lexically_normal();
+
+    if (relativePath.empty() || relativePath.has_root_path() || relativePath == "." || *relativePath.begin() == "..")
+    {
+        Logger::error("Invalid backup path (Path: {})", path);
+        return false;
+    }
+
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    const std::filesystem::path& backupPath = std::filesystem::path(_backupDir) / relativePath;
+
+    std::error_code error;
+
+    std::filesystem::create_directories(backupPath.parent_path(), error);
+
+    if (error)
+    {
+        Logger::error("Can\'t create backup directory ({})", error.message());
+        return false;
+    }
+
+    return chain->clone(Chain(backupPath, _options));
+}
+
+bool Manager::cloneChain(const size_t chainId, const size_t targetChainId) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    if (hasChain(targetChainId))
+    {
+        Logger::error("Chain already exists (Chain ID: {})", targetChainId);
+        return false;
+    }
+
+    if (!reclaimChain(targetChainId))
+    {
+        return false;
+    }
+
+    const Chain::Ptr target = makeChain(targetChainId);
+
+    if (!target || !chain->clone(*target))
+    {
+        return false;
+    }
+
+    Catalog::Entry entry;
+
+    return _catalog->getChain(chainId, entry) && addCatalogEntry(targetChainId, *chain, entry.createdAt);
+}
+
+bool Manager::verifyChain(const size_t chainId) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr header = chain->getHeader();
+
+    if (!header)
+    {
+        Logger::error("Can\'t get header");
+        return false;
+    }
+
+    BlockList blocks;
+
+    if (!chain->getBlocks(blocks))
+    {
+        Logger::error("Can\'t get blocks");
+        return false;
+    }
+
+    for (size_t index = 0; index < blocks.size(); index++)
+    {
+        SHA256::Hash::Ptr prevHash;
+
+        if (index == 0)
+        {
+            prevHash = SHA256::getHashN({
+                header->getData(),
+                {reinterpret_cast<const char*>(header->getPrivateKey()->data()), header->getPrivateKey()->length()},
+                {reinterpret_cast<const char*>(header->getPublicKey()->data()), header->getPublicKey()->length()}
+            });
+
+            if (!prevHash)
+            {
+                Logger::error("Can\'t calculate header hash");
+                return false;
+            }
+        }
+        else
+        {
+            const Block::Ptr lastBlock = blocks[index - 1];
+
+            prevHash = lastBlock->getData()->getHash();
+        }
+
+        const Block::Ptr block = blocks[index];
+
+        if (block->getData()->isPruned())
+        {
+            if (memcmp(block->getData()->getPrevHash()->data(), prevHash->data(), prevHash->length()))
+            {
+                Logger::error("Previous hash is not valid (Index: {})", index);
+                return false;
+            }
+
+            continue;
+        }
+
+        const std::string& chunkData = Block::Container::encodeChunks(block->getData()->getChunks());
+
+        const SHA256::Hash::Ptr bodyHash = SHA256::getHash({
+            {reinterpret_cast<const char*>(prevHash->data()), prevHash->length()},
+            {reinterpret_cast<const char*>(block->getData()->getNonce()->data()), block->getData()->getNonce()->length()},
+            block->getData()->getData(),
+            chunkData
+        });
+
+        if (!_secp256k1.verifySignature(bodyHash, header->getPublicKey(), block->getData()->getSignature()))
+        {
+            Logger::error("Signature is not valid (Index: {})", index);
+            return false;
+        }
+
+        const SHA256::Hash::Ptr hash = SHA256::getHash({
+            {reinterpret_cast<const char*>(prevHash->data()), prevHash->length()},
+            {reinterpret_cast<const char*>(block->getData()->getNonce()->data()), block->getData()->getNonce()->length()},
+            block->getData()->getData(),
+            chunkData,
+            {reinterpret_cast<const char*>(block->getData()->getSignature()->data()), block->getData()->getSignature()->length()},
+        });
+
+        if (!hash)
+        {
+            Logger::error("Can\'t calculate block hash (Index: {})", index);
+            return false;
+        }
+
+        if (memcmp(block->getData()->getHash()->data(), hash->data(), hash->length()))
+        {
+            Logger::error("Hash is not valid (Index: {})", index);
+            return false;
+        }
+
+        for (const SHA256::Hash::Ptr& chunk : block->getData()->getChunks())
+        {
+            std::string data;
+
+            if (!chain->getChunk(chunk, data))
+            {
+                Logger::error("Chunk not found (Index: {})", index);
+                return false;
+            }
+
+            const SHA256::Hash::Ptr chunkHash = SHA256::getHash({data});
+
+            if (!chunkHash || memcmp(chunk->data(), chunkHash->data(), chunkHash->length()))
+            {
+                Logger::error("Chunk is not valid (Index: {})", index);
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
-Manager::~Manager()
+bool Manager::setRetention(const size_t chainId, const size_t retainBlocks, const uint64_t retainAge) const
 {
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    return chain->setRetention(retainBlocks, retainAge);
 }
 
-Chain::Ptr Manager::createChain(const size_t chainId, const std::string& data) const
+bool Manager::pruneChain(const size_t chainId, const uint64_t now, size_t& count) const
 {
-    const Crypto::Secp256k1::PrivateKey::Ptr privateKey = _secp256k1.generatePrivateKey();
+    const Chain::Ptr chain = getChain(chainId);
 
-    if (!privateKey)
+    if (!chain)
     {
-        Logger::error("Can\'t generate private key");
-        return nullptr;
+        return false;
     }
 
-    const Crypto::Secp256k1::PublicKey::Ptr publicKey = _secp256k1.createPublicKey(privateKey);
+    return chain->prune(now, count);
+}
 
-    if (!publicKey)
+bool Manager::archiveChain(const size_t chainId, const size_t threshold, size_t& count) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    return chain->archive(threshold, count);
+}
+
+Chain::Header::Ptr Manager::getChainHeader(const size_t chainId) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
     {
-        Logger::error("Can\'t create public key");
         return nullptr;
     }
 
-    const Chain::Ptr chain(new Chain(makeStoragePath(chainId)));
+    const Chain::Header::Ptr header = chain->getHeader();
 
-    if (!chain->create(data, privateKey, publicKey))
+    if (!header)
     {
+        Logger::error("Can\'t get header");
         return nullptr;
     }
 
-    return chain;
+    return header;
 }
 
-Block::Ptr Manager::addBlock(const size_t chainId, const std::string& data) const
+bool Manager::getChainInfo(const size_t chainId, size_t& version, size_t& index) const
 {
-    const Chain chain(makeStoragePath(chainId));
+    ChainInfo info;
 
-    const Chain::Header::Ptr header = chain.getHeader();
+    if (!getChainInfo(chainId, info))
+    {
+        return false;
+    }
+
+    version = info.version;
+    index = info.index;
+
+    return true;
+}
+
+bool Manager::getChainInfo(const size_t chainId, ChainInfo& info) const
+{
+    const Chain::Ptr chain = getChain(chainId);
+
+    if (!chain)
+    {
+        return false;
+    }
+
+    const Chain::Header::Ptr header = chain->getHeader();
 
     if (!header)
     {
         Logger::error("Can\'t get header");
-        return nullptr;
+        return false;
     }
 
-    SHA256::Hash::Ptr prevHash;
-
-    if (!header->getIndex())
+    info.version = header->getVersion();
+    info.index = header->getIndex();
+    info.durability = header->getDurability();
+    info.engine = header->getEngine();
+    info.dedup = header->isDedup();
+    info.retainBlocks = header->getRetainBlocks();
+    info.retainAge = header->getRetainAge();
+
+    if (!chain->getSize(info.dataSize, info.storageSize) ||
+        !chain->getDedupSize(info.payloadSize, info.storedPayloadSize) ||
+        !chain->getPrunedIndex(info.prunedIndex) ||
+        !chain->getArchiveInfo(info.archivedIndex, info.archiveSize))
     {
-        prevHash = SHA256::getHashN({
-            header->getData(),
-            {reinterpret_cast<const char*>(header->getPrivateKey()->data()), header->getPrivateKey()->length()},
-            {reinterpret_cast<const char*>(header->getPublicKey()->data()), header->getPublicKey()->length()}
-        });
+        Logger::error("Can\'t get chain size");
+        return false;
+    }
 
-        if (!prevHash)
-        {
-            Logger::error("Can\'t calculate header hash");
-            return nullptr;
-        }
+    return true;
+}
+
+bool Manager::upgradeChains() const
+{
+    if (_layout == SHARED)
+    {
+        return _database != nullptr && rebuildCatalog();
     }
-    else
+
+    std::error_code error;
+
+    std::filesystem::directory_iterator it(_storageDir, error);
+
+    if (error)
     {
-        const Block::Ptr lastBlock = chain.getBlock(header->getIndex());
+        Logger::error("Can\'t read storage directory ({})", error.message());
+        return false;
+    }
+
+    bool status = true;
 
-        if (!lastBlock)
+    for (const std::filesystem::directory_entry& entry : it)
+    {
+        if (entry.path().extension() != ".blockchain")
         {
-            Logger::error("Can\'t get last block");
-            return nullptr;
+            continue;
         }
 
-        prevHash = lastBlock->getData()->getHash();
+        Chain chain(entry.path(), _options);
+
+        if (!chain.open() || !chain.close())
+        {
+            Logger::error("Can\'t upgrade chain (Path: {})", entry.path().string());
+            status = false;
+        }
     }
 
+    return rebuildCatalog() && status;
+}
+
+Block::Ptr Manager::makeBlock(const Chain::Header::Ptr header,
+    const SHA256::Hash::Ptr prevHash,
+    const std::string& data,
+    const Block::Container::ChunkList& chunks) const
+{
     const Block::Container::Nonce::Ptr nonce = Block::generateNonce();
 
     if (!nonce)
@@ -114,10 +835,13 @@ Block::Ptr Manager::addBlock(const size_t chainId, const std::string& data) cons
         return nullptr;
     }
 
+    const std::string& chunkData = Block::Container::encodeChunks(chunks);
+
     const SHA256::Hash::Ptr bodyHash = SHA256::getHash({
         {reinterpret_cast<const char*>(prevHash->data()), prevHash->length()},
         {reinterpret_cast<const char*>(nonce->data()), nonce->length()},
-        data
+        data,
+        chunkData
     });
 
     if (!bodyHash)
@@ -138,6 +862,7 @@ Block::Ptr Manager::addBlock(const size_t chainId, const std::string& data) cons
         {reinterpret_cast<const char*>(prevHash->data()), prevHash->length()},
         {reinterpret_cast<const char*>(nonce->data()), nonce->length()},
         data,
+        chunkData,
         {reinterpret_cast<const char*>(signature->data()), signature->length()},
     });
 
@@ -147,120 +872,135 @@ Block::Ptr Manager::addBlock(const size_t chainId, const std::string& data) cons
         return nullptr;
     }
 
+    const uint64_t timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
     const Block::Container::Ptr container = std::make_shared<Block::Container>(
         hash,
         prevHash,
         nonce,
         data,
-        signature);
-
-    const Block::Ptr block(new Block(container));
-
-    if (!chain.addBlock(block))
-    {
-        Logger::error("Can\'t add block");
-        return nullptr;
-    }
+        signature,
+        chunks,
+        nullptr,
+        timestamp);
 
-    return block;
+    return std::make_shared<Block>(container);
 }
 
-Block::Ptr Manager::getBlock(const size_t chainId, const size_t index) const
+Chain::Ptr Manager::getChain(const size_t chainId) const
 {
-    const Chain chain(makeStoragePath(chainId));
+    return _cache.get(chainId, [this, chainId]() -> Chain::Ptr {
+        if (!hasChain(chainId))
+        {
+            Logger::error("Chain not found (Chain ID: {})", chainId);
+            return nullptr;
+        }
 
-    return chain.getBlock(index);
-}
+        const Chain::Ptr chain = makeChain(chainId);
 
-bool Manager::getBlocks(const size_t chainId, BlockList& blocks) const
-{
-    const Chain chain(makeStoragePath(chainId));
+        if (!chain || !chain->open())
+        {
+            Logger::error("Can't open chain (Chain ID: {})", chainId);
+            return nullptr;
+        }
 
-    return chain.getBlocks(blocks);
+        return chain;
+    });
 }
 
-bool Manager::removeChain(const size_t chainId) const
+Chain::Ptr Manager::makeChain(const size_t chainId) const
 {
-    const Chain chain(makeStoragePath(chainId));
+    if (_layout == SHARED)
+    {
+        if (!_database)
+        {
+            Logger::error("Shared storage is not open");
+            return nullptr;
+        }
 
-    return chain.remove();
+        return std::make_shared<Chain>(_database, makeStoragePrefix(chainId), makeStoragePath(chainId) + ".log");
+    }
+
+    return std::make_shared<Chain>(makeStoragePath(chainId), _options);
 }
 
-bool Manager::verifyChain(const size_t chainId) const
+bool Manager::addCatalogEntry(const size_t chainId, const Chain& chain, const uint64_t createdAt) const
 {
-    const Chain chain(makeStoragePath(chainId));
-
     const Chain::Header::Ptr header = chain.getHeader();
+    uint64_t dataSize = 0;
 
-    if (!header)
+    if (!header || !chain.getDataSize(dataSize))
     {
-        Logger::error("Can\'t get header");
+        Logger::error("Can\'t get chain state (Chain ID: {})", chainId);
         return false;
     }
 
-    BlockList blocks;
-
-    if (!chain.getBlocks(blocks))
+    if (!_catalog || !_catalog->addChain({chainId, static_cast<uint32_t>(_layout), createdAt, header->getIndex(), dataSize}))
     {
-        Logger::error("Can\'t get blocks");
+        Logger::error("Can\'t add chain to catalog (Chain ID: {})", chainId);
         return false;
     }
 
-    for (size_t index = 0; index < blocks.size(); index++)
+    return true;
+}
+
+void Manager::updateCatalogEntries(const Cache::ChainList& chains) const
+{
+    if (!_catalog)
     {
-        SHA256::Hash::Ptr prevHash;
+        return;
+    }
 
-        if (index == 0)
-        {
-            prevHash = SHA256::getHashN({
-                header->getData(),
-                {reinterpret_cast<const char*>(header->getPrivateKey()->data()), header->getPrivateKey()->length()},
-                {reinterpret_cast<const char*>(header->getPublicKey()->data()), header->getPublicKey()->length()}
-            });
+    Catalog::EntryList entries;
 
-            if (!prevHash)
-            {
-                Logger::error("Can\'t calculate header hash");
-                return false;
-            }
-        }
-        else
-        {
-            const Block::Ptr lastBlock = blocks[index - 1];
+    for (const auto& [chainId, chain] : chains)
+    {
+        const Chain::Header::Ptr header = chain->getHeader();
+        uint64_t dataSize = 0;
 
-            prevHash = lastBlock->getData()->getHash();
+        if (!header || !chain->getDataSize(dataSize))
+        {
+            Logger::error("Can\'t get chain state (Chain ID: {})", chainId);
+            continue;
         }
 
-        const Block::Ptr block = blocks[index];
+        entries.push_back({chainId, static_cast<uint32_t>(_layout), 0, header->getIndex(), dataSize});
+    }
 
-        const SHA256::Hash::Ptr bodyHash = SHA256::getHash({
-            {reinterpret_cast<const char*>(prevHash->data()), prevHash->length()},
-            {reinterpret_cast<const char*>(block->getData()->getNonce()->data()), block->getData()->getNonce()->length()},
-            block->getData()->getData()
-        });
+    if (!_catalog->updateChains(entries))
+    {
+        Logger::error("Can\'t update chain catalog");
+    }
+}
 
-        if (!_secp256k1.verifySignature(bodyHash, header->getPublicKey(), block->getData()->getSignature()))
-        {
-            Logger::error("Signature is not valid (Index: {})", index);
-            return false;
-        }
+bool Manager::rebuildCatalog() const
+{
+    if (!_catalog)
+    {
+        Logger::error("Chain catalog is not open");
+        return false;
+    }
 
-        const SHA256::Hash::Ptr hash = SHA256::getHash({
-            {reinterpret_cast<const char*>(prevHash->data()), prevHash->length()},
-            {reinterpret_cast<const char*>(block->getData()->getNonce()->data()), block->getData()->getNonce()->length()},
-            block->getData()->getData(),
-            {reinterpret_cast<const char*>(block->getData()->getSignature()->data()), block->getData()->getSignature()->length()},
-        });
+    std::vector<size_t> chainIds;
 
-        if (!hash)
+    if (!getChainIds(chainIds))
+    {
+        return false;
+    }
+
+    for (const size_t chainId : chainIds)
+    {
+        if (_catalog->hasChain(chainId) || _catalog->hasTombstone(chainId))
         {
-            Logger::error("Can\'t calculate block hash (Index: {})", index);
-            return false;
+            continue;
         }
 
-        if (memcmp(block->getData()->getHash()->data(), hash->data(), hash->length()))
+        const Chain::Ptr chain = makeChain(chainId);
+
+        if (!chain || !chain->open() || !addCatalogEntry(chainId, *chain, 0) || !chain->close())
         {
-            Logger::error("Hash is not valid (Index: {})", index);
+            Logger::error("Can\'t add chain to catalog (Chain ID: {})", chainId);
             return false;
         }
     }
@@ -268,35 +1008,87 @@ bool Manager::verifyChain(const size_t chainId) const
     return true;
 }
 
-Chain::Header::Ptr Manager::getChainHeader(const size_t chainId) const
+bool Manager::reclaimChain(const size_t chainId) const
 {
-    const Chain chain(makeStoragePath(chainId));
-
-    const Chain::Header::Ptr header = chain.getHeader();
+    if (!_catalog->hasTombstone(chainId))
+    {
+        return true;
+    }
 
-    if (!header)
+    if (!_reclaimer->reclaimChain(chainId))
     {
-        Logger::error("Can\'t get header");
-        return nullptr;
+        Logger::error("Can\'t reclaim removed chain (Chain ID: {})", chainId);
+        return false;
     }
 
-    return header;
+    return true;
 }
 
-bool Manager::getChainInfo(const size_t chainId, size_t& version, size_t& index) const
+bool Manager::getChainIds(std::vector<size_t>& chainIds) const
 {
-    const Chain chain(makeStoragePath(chainId));
+    const auto parseId = [](const std::string_view data, size_t& chainId)
+    {
+        const std::from_chars_result result = std::from_chars(data.data(), data.data() + data.size(), chainId);
 
-    const Chain::Header::Ptr header = chain.getHeader();
+        return result.ec == std::errc() && result.ptr == data.data() + data.size();
+    };
 
-    if (!header)
+    if (_layout == SHARED)
     {
-        Logger::error("Can\'t get header");
+        if (!_database)
+        {
+            Logger::error("Shared storage is not open");
+            return false;
+        }
+
+        const Storage::Iterator::Ptr it = _database->scan(DB_CHAIN_KEY);
+
+        if (!it)
+        {
+            return false;
+        }
+
+        for (it->seek(DB_CHAIN_KEY); it->isValid();)
+        {
+            const std::string& key = it->getKey();
+            const size_t offset = DB_CHAIN_KEY.size();
+            const size_t end = key.find('/', offset);
+
+            size_t chainId = 0;
+
+            if (end == std::string::npos || !parseId(std::string_view(key).substr(offset, end - offset), chainId))
+            {
+                Logger::error("Can\'t parse chain key");
+                return false;
+            }
+
+            chainIds.push_back(chainId);
+
+            it->seek(makeStoragePrefix(chainId + 1));
+        }
+
+        return it->getStatus();
+    }
+
+    std::error_code error;
+
+    std::filesystem::directory_iterator it(_storageDir, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t read storage directory ({})", error.message());
         return false;
     }
 
-    version = header->getVersion();
-    index = header->getIndex();
+    for (const std::filesystem::directory_entry& entry : it)
+    {
+        size_t chainId = 0;
+
+        if (entry.path().extension() == ".blockchain" && parseId(entry.path().stem().string(), chainId))
+        {
+            chainIds.push_back(chainId);
+        }
+    }
 
     return true;
 }
@@ -306,4 +1098,13 @@ std::string Manager::makeStoragePath(const size_t chainId) const
     const std::string& name = std::to_string(chainId) + ".blockchain";
 
     return std::filesystem::path(_storageDir) / std::filesystem::path(name);
+}
+
+std::string Manager::makeStoragePrefix(const size_t chainId) const
+{
+    std::string id = std::to_string(chainId);
+
+    id.insert(0, 20 - id.size(), '0');
+
+    return DB_CHAIN_KEY + id + "/";
 }
\ No newline at end of file
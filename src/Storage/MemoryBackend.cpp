@@ -0,0 +1,571 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+#include "Storage/MemoryBackend.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+const size_t MAX_HEIGHT = 12;
+const size_t BRANCHING = 4;
+
+MemoryBackend::Table::Node::Node(const std::string& key, const size_t height) :
+    key(key),
+    version(nullptr),
+    next(new std::atomic<Node*>[height]())
+{
+}
+
+MemoryBackend::Table::Node::~Node()
+{
+    Version* version = this->version.load(std::memory_order_relaxed);
+
+    while (version)
+    {
+        Version* prev = version->prev;
+
+        delete version;
+
+        version = prev;
+    }
+}
+
+MemoryBackend::Table::Table() :
+    _head(new Node("", MAX_HEIGHT)),
+    _height(1),
+    _sequence(0),
+    _readers(0),
+    _random(0xdeadbeef)
+{
+}
+
+MemoryBackend::Table::~Table()
+{
+    Node* node = _head;
+
+    while (node)
+    {
+        Node* next = node->next[0].load(std::memory_order_relaxed);
+
+        delete node;
+
+        node = next;
+    }
+}
+
+uint64_t MemoryBackend::Table::acquire() const
+{
+    _readers.fetch_add(1);
+
+    return _sequence.load();
+}
+
+void MemoryBackend::Table::release() const
+{
+    _readers.fetch_sub(1);
+}
+
+MemoryBackend::Table::Node* MemoryBackend::Table::findGreaterOrEqual(const std::string_view key) const
+{
+    return findGreaterOrEqual(key, nullptr);
+}
+
+MemoryBackend::Table::Node* MemoryBackend::Table::findGreaterOrEqual(const std::string_view key, Node** prev) const
+{
+    Node* node = _head;
+    size_t level = _height.load(std::memory_order_relaxed) - 1;
+
+    while (true)
+    {
+        Node* next = node->next[level].load(std::memory_order_acquire);
+
+        if (next && next->key < key)
+        {
+            node = next;
+            continue;
+        }
+
+        if (prev)
+        {
+            prev[level] = node;
+        }
+
+        if (!level)
+        {
+            return next;
+        }
+
+        level--;
+    }
+}
+
+MemoryBackend::Table::Node* MemoryBackend::Table::findLessThan(const std::string_view key) const
+{
+    Node* node = _head;
+    size_t level = _height.load(std::memory_order_relaxed) - 1;
+
+    while (true)
+    {
+        Node* next = node->next[level].load(std::memory_order_acquire);
+
+        if (next && next->key < key)
+        {
+            node = next;
+            continue;
+        }
+
+        if (!level)
+        {
+            return node == _head ? nullptr : node;
+        }
+
+        level--;
+    }
+}
+
+MemoryBackend::Table::Node* MemoryBackend::Table::findLast() const
+{
+    Node* node = _head;
+    size_t level = _height.load(std::memory_order_relaxed) - 1;
+
+    while (true)
+    {
+        Node* next = node->next[level].load(std::memory_order_acquire);
+
+        if (next)
+        {
+            node = next;
+            continue;
+        }
+
+        if (!level)
+        {
+            return node == _head ? nullptr : node;
+        }
+
+        level--;
+    }
+}
+
+const MemoryBackend::Table::Version* MemoryBackend::Table::getVersion(const Node* node, const uint64_t sequence) const
+{
+    const Version* version = node->version.load(std::memory_order_acquire);
+
+    while (version && version->sequence > sequence)
+    {
+        version = version->prev;
+    }
+
+    return version && !version->deleted ? version : nullptr;
+}
+
+void MemoryBackend::Table::write(const Storage::KeyValueList& pairs, const Storage::KeyList& keys)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const uint64_t sequence = _sequence.load(std::memory_order_relaxed) + 1;
+
+    for (const Storage::KeyValue::Data& key : keys)
+    {
+        apply(key, nullptr, sequence);
+    }
+
+    for (const Storage::KeyValue& pair : pairs)
+    {
+        const Storage::KeyValue::Data& value = pair.getValue();
+
+        apply(pair.getKey(), &value, sequence);
+    }
+
+    _sequence.store(sequence);
+
+    if (!_obsolete.empty() && !_readers.load())
+    {
+        trim();
+    }
+}
+
+void MemoryBackend::Table::apply(const std::string& key, const std::string* value, const uint64_t sequence)
+{
+    Node* prev[MAX_HEIGHT];
+
+    Node* node = findGreaterOrEqual(key, prev);
+
+    if (node && node->key == key)
+    {
+        Version* version = node->version.load(std::memory_order_relaxed);
+
+        if (!version->prev)
+        {
+            _obsolete.push_back(node);
+        }
+
+        node->version.store(new Version{sequence, !value, value ? *value : std::string(), version},
+            std::memory_order_release);
+
+        return;
+    }
+
+    if (!value)
+    {
+        return;
+    }
+
+    const size_t height = makeHeight();
+    const size_t currentHeight = _height.load(std::memory_order_relaxed);
+
+    for (size_t level = currentHeight; level < height; level++)
+    {
+        prev[level] = _head;
+    }
+
+    if (height > currentHeight)
+    {
+        _height.store(height, std::memory_order_relaxed);
+    }
+
+    node = new Node(key, height);
+
+    node->version.store(new Version{sequence, false, *value, nullptr}, std::memory_order_relaxed);
+
+    for (size_t level = 0; level < height; level++)
+    {
+        node->next[level].store(prev[level]->next[level].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        prev[level]->next[level].store(node, std::memory_order_release);
+    }
+}
+
+void MemoryBackend::Table::trim()
+{
+    for (Node* node : _obsolete)
+    {
+        Version* version = node->version.load(std::memory_order_relaxed);
+
+        Version* prev = version->prev;
+
+        version->prev = nullptr;
+
+        while (prev)
+        {
+            version = prev->prev;
+
+            delete prev;
+
+            prev = version;
+        }
+    }
+
+    _obsolete.clear();
+}
+
+size_t MemoryBackend::Table::makeHeight()
+{
+    size_t height = 1;
+
+    while (height < MAX_HEIGHT)
+    {
+        _random ^= _random << 13;
+        _random ^= _random >> 17;
+        _random ^= _random << 5;
+
+        if (_random % BRANCHING)
+        {
+            break;
+        }
+
+        height++;
+    }
+
+    return height;
+}
+
+MemoryBackend::Cursor::Cursor(const Table::Ptr& table) :
+    _table(table),
+    _sequence(table->acquire()),
+    _node(nullptr),
+    _version(nullptr)
+{
+}
+
+MemoryBackend::Cursor::~Cursor()
+{
+    _table->release();
+}
+
+void MemoryBackend::Cursor::seek(const std::string_view key)
+{
+    _node = _table->findGreaterOrEqual(key);
+
+    skipForward();
+}
+
+void MemoryBackend::Cursor::next()
+{
+    _node = _node->next[0].load(std::memory_order_acquire);
+
+    skipForward();
+}
+
+void MemoryBackend::Cursor::prev()
+{
+    _node = _table->findLessThan(_node->key);
+
+    skipBackward();
+}
+
+bool MemoryBackend::Cursor::isValid() const
+{
+    return _node != nullptr;
+}
+
+bool MemoryBackend::Cursor::getStatus() const
+{
+    return true;
+}
+
+std::string_view MemoryBackend::Cursor::getKey() const
+{
+    return _node->key;
+}
+
+std::string_view MemoryBackend::Cursor::getValue() const
+{
+    return _version->value;
+}
+
+void MemoryBackend::Cursor::skipForward()
+{
+    while (_node && !(_version = _table->getVersion(_node, _sequence)))
+    {
+        _node = _node->next[0].load(std::memory_order_acquire);
+    }
+}
+
+void MemoryBackend::Cursor::skipBackward()
+{
+    while (_node && !(_version = _table->getVersion(_node, _sequence)))
+    {
+        _node = _table->findLessThan(_node->key);
+    }
+}
+
+MemoryBackend::MemoryBackend(const std::string& path) :
+    _path(path)
+{
+}
+
+MemoryBackend::~MemoryBackend()
+{
+}
+
+bool MemoryBackend::create()
+{
+    std::lock_guard<std::mutex> lock(getTablesMutex());
+
+    TableMap& tables = getTables();
+
+    if (tables.count(_path))
+    {
+        Logger::error("Can\'t create DB (Path: {} already exists)", _path);
+        return false;
+    }
+
+    _table = std::make_shared<Table>();
+
+    tables.emplace(_path, _table);
+
+    return true;
+}
+
+bool MemoryBackend::open()
+{
+    std::lock_guard<std::mutex> lock(getTablesMutex());
+
+    const TableMap& tables = getTables();
+
+    const auto it = tables.find(_path);
+
+    if (it == tables.end())
+    {
+        Logger::error("Can\'t open DB (Path: {} does not exist)", _path);
+        return false;
+    }
+
+    _table = it->second;
+
+    return true;
+}
+
+bool MemoryBackend::close()
+{
+    _table = nullptr;
+
+    return true;
+}
+
+bool MemoryBackend::exists() const
+{
+    std::lock_guard<std::mutex> lock(getTablesMutex());
+
+    return getTables().count(_path);
+}
+
+bool MemoryBackend::get(const Storage::KeyValue::Data& key, Storage::Slice& value, bool& isFound) const
+{
+    const Table::Ptr table = _table;
+    const uint64_t sequence = table->acquire();
+
+    const std::shared_ptr<void> pin(nullptr, [table](void*) {
+        table->release();
+    });
+
+    const Table::Node* node = table->findGreaterOrEqual(key);
+    const Table::Version* version = node && node->key == key ? table->getVersion(node, sequence) : nullptr;
+
+    isFound = version != nullptr;
+
+    if (isFound)
+    {
+        value = Storage::Slice(version->value, pin, true);
+    }
+
+    return true;
+}
+
+bool MemoryBackend::multiGet(const Storage::KeyList& keys,
+    std::vector<Storage::Slice>& values,
+    Storage::StatusList& statuses) const
+{
+    const Table::Ptr table = _table;
+    const uint64_t sequence = table->acquire();
+
+    const std::shared_ptr<void> pin(nullptr, [table](void*) {
+        table->release();
+    });
+
+    values.assign(keys.size(), Storage::Slice());
+    statuses.assign(keys.size(), false);
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        const Table::Node* node = table->findGreaterOrEqual(keys[i]);
+        const Table::Version* version = node && node->key == keys[i] ? table->getVersion(node, sequence) : nullptr;
+
+        if (version)
+        {
+            values[i] = Storage::Slice(version->value, pin, true);
+            statuses[i] = true;
+        }
+    }
+
+    return true;
+}
+
+Storage::Backend::Cursor::Ptr MemoryBackend::scan(const Storage::ReadOptions&) const
+{
+    return std::make_unique<Cursor>(_table);
+}
+
+bool MemoryBackend::write(const Storage::KeyValueList& pairs, const Storage::KeyList& keys, const bool) const
+{
+    _table->write(pairs, keys);
+
+    return true;
+}
+
+bool MemoryBackend::ingest(const Storage::KeyValueList& pairs) const
+{
+    _table->write(pairs, {});
+
+    return true;
+}
+
+bool MemoryBackend::checkpoint(const std::string& path) const
+{
+    MemoryBackend target(path);
+
+    if (!target.create())
+    {
+        return false;
+    }
+
+    const bool status = copy(target, "", "");
+
+    target.close();
+
+    return status;
+}
+
+bool MemoryBackend::sync() const
+{
+    return true;
+}
+
+bool MemoryBackend::getApproximateSize(const Storage::KeyValue::Data& start,
+    const Storage::KeyValue::Data& limit,
+    uint64_t& size) const
+{
+    Cursor cursor(_table);
+
+    size = 0;
+
+    for (cursor.seek(start); cursor.isValid() && (limit.empty() || cursor.getKey() < limit); cursor.next())
+    {
+        size += cursor.getKey().size() + cursor.getValue().size();
+    }
+
+    return true;
+}
+
+bool MemoryBackend::reclaim(const uint64_t, uint64_t&, bool& isDone) const
+{
+    isDone = remove();
+
+    return isDone;
+}
+
+bool MemoryBackend::compact(const Storage::KeyValue::Data&, const Storage::KeyValue::Data&) const
+{
+    return true;
+}
+
+bool MemoryBackend::remove() const
+{
+    std::lock_guard<std::mutex> lock(getTablesMutex());
+
+    getTables().erase(_path);
+
+    return true;
+}
+
+std::mutex& MemoryBackend::getTablesMutex()
+{
+    static std::mutex mutex;
+
+    return mutex;
+}
+
+MemoryBackend::TableMap& MemoryBackend::getTables()
+{
+    static TableMap tables;
+
+    return tables;
+}
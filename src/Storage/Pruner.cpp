@@ -0,0 +1,108 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+
+#include <vector>
+
+#include "Storage/Pruner.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+Pruner::Pruner(const Cache& cache, const size_t interval, const size_t archiveThreshold) :
+    _cache(cache),
+    _interval(interval),
+    _archiveThreshold(archiveThreshold),
+    _isStopped(true)
+{
+}
+
+Pruner::~Pruner()
+{
+    stop();
+}
+
+void Pruner::start()
+{
+    if (!_interval.count() || _thread.joinable())
+    {
+        return;
+    }
+
+    _isStopped = false;
+
+    _thread = std::thread(&Pruner::process, this);
+}
+
+void Pruner::stop()
+{
+    if (!_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _isStopped = true;
+    }
+
+    _condition.notify_all();
+
+    _thread.join();
+}
+
+void Pruner::process()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_condition.wait_for(lock, _interval, [this]() { return _isStopped; }))
+    {
+        lock.unlock();
+
+        std::vector<Chain::Ptr> chains;
+
+        _cache.forEach([&chains](const Chain::Ptr& chain) {
+            chains.push_back(chain);
+        });
+
+        const uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        for (const Chain::Ptr& chain : chains)
+        {
+            size_t count = 0;
+
+            if (!chain->prune(now, count))
+            {
+                Logger::error("Can\'t prune chain");
+            }
+
+            if (_archiveThreshold && !chain->archive(_archiveThreshold, count))
+            {
+                Logger::error("Can\'t archive chain");
+            }
+        }
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,211 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <limits>
+#include <algorithm>
+
+#include "Storage/Reclaimer.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+Reclaimer::Reclaimer(const Catalog& catalog,
+    const ChainFactory& factory,
+    const size_t interval,
+    const uint64_t rate,
+    const UsageCheck& isInUse) :
+    _catalog(catalog),
+    _factory(factory),
+    _isInUse(isInUse),
+    _interval(interval),
+    _rate(rate),
+    _isStopped(true),
+    _reclaimedChains(0),
+    _reclaimedBytes(0)
+{
+}
+
+Reclaimer::~Reclaimer()
+{
+    stop();
+}
+
+void Reclaimer::start()
+{
+    if (!_interval.count() || _thread.joinable())
+    {
+        return;
+    }
+
+    _isStopped = false;
+
+    _thread = std::thread(&Reclaimer::process, this);
+}
+
+void Reclaimer::stop()
+{
+    if (!_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _isStopped = true;
+    }
+
+    _condition.notify_all();
+
+    _thread.join();
+}
+
+bool Reclaimer::reclaimChain(const size_t chainId)
+{
+    uint64_t bytes = 0;
+
+    if (!reclaimChain(chainId, std::numeric_limits<uint64_t>::max(), bytes))
+    {
+        return false;
+    }
+
+    if (_catalog.hasTombstone(chainId))
+    {
+        Logger::error("Removed chain is still in use (Chain ID: {})", chainId);
+        return false;
+    }
+
+    return true;
+}
+
+bool Reclaimer::reclaim(const uint64_t maxBytes)
+{
+    std::vector<size_t> chainIds;
+
+    if (!_catalog.getTombstones(chainIds))
+    {
+        return false;
+    }
+
+    uint64_t bytes = 0;
+
+    for (const size_t chainId : chainIds)
+    {
+        if (bytes >= maxBytes)
+        {
+            break;
+        }
+
+        uint64_t used = 0;
+
+        if (!reclaimChain(chainId, maxBytes - bytes, used))
+        {
+            return false;
+        }
+
+        bytes += used;
+    }
+
+    return true;
+}
+
+bool Reclaimer::getStats(Stats& stats) const
+{
+    std::vector<size_t> chainIds;
+
+    if (!_catalog.getTombstones(chainIds))
+    {
+        return false;
+    }
+
+    stats.pendingChains = chainIds.size();
+    stats.reclaimedChains = _reclaimedChains;
+    stats.reclaimedBytes = _reclaimedBytes;
+
+    return true;
+}
+
+void Reclaimer::process()
+{
+    const uint64_t maxBytes = _rate ?
+        std::max<uint64_t>(_rate * _interval.count() / 1000, 1) :
+        std::numeric_limits<uint64_t>::max();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_condition.wait_for(lock, _interval, [this]() { return _isStopped; }))
+    {
+        lock.unlock();
+
+        if (!reclaim(maxBytes))
+        {
+            Logger::error("Can\'t reclaim removed chains");
+        }
+
+        lock.lock();
+    }
+}
+
+bool Reclaimer::reclaimChain(const size_t chainId, const uint64_t maxBytes, uint64_t& bytes)
+{
+    std::lock_guard<std::mutex> lock(_reclaimMutex);
+
+    if (!_catalog.hasTombstone(chainId))
+    {
+        return true;
+    }
+
+    // Files and keys of a chain are deleted only after its last handle is closed
+    if (_isInUse && _isInUse(chainId))
+    {
+        Logger::debug("Defer reclaiming chain in use (Chain ID: {})", chainId);
+        return true;
+    }
+
+    const Chain::Ptr chain = _factory(chainId);
+
+    bool isDone = false;
+
+    if (!chain || !chain->reclaim(maxBytes, bytes, isDone))
+    {
+        Logger::error("Can\'t reclaim chain (Chain ID: {})", chainId);
+        return false;
+    }
+
+    _reclaimedBytes += bytes;
+
+    if (!isDone)
+    {
+        return true;
+    }
+
+    if (!_catalog.removeTombstone(chainId))
+    {
+        return false;
+    }
+
+    _reclaimedChains++;
+
+    Logger::info("Reclaimed chain (Chain ID: {})", chainId);
+
+    return true;
+}
@@ -20,11 +20,20 @@
    SOFTWARE.
 */
 
+#include <algorithm>
+#include <filesystem>
+
+#include "Defs.h"
 #include "Storage/Storage.h"
+#include "Storage/DiskBackend.h"
+#include "Storage/MemoryBackend.h"
 #include "System/Logger.h"
 
 using namespace Core::Storage;
 
+const size_t REMOVE_BATCH_SIZE = 1024;
+const size_t COPY_BATCH_SIZE = 1024;
+
 Storage::KeyValue::KeyValue(const Data& key, const Data& value) :
     _key(key),
     _value(value)
@@ -35,159 +44,831 @@ Storage::KeyValue::~KeyValue()
 {
 }
 
-Storage::KeyValue::Data Storage::KeyValue::getKey() const
+const Storage::KeyValue::Data& Storage::KeyValue::getKey() const
 {
     return _key;
 }
 
-Storage::KeyValue::Data Storage::KeyValue::getValue() const
+const Storage::KeyValue::Data& Storage::KeyValue::getValue() const
 {
     return _value;
 }
 
-Storage::Storage(const std::string& path) :
+Storage::Slice::Slice() :
+    _isPinned(false)
+{
+}
+
+Storage::Slice::Slice(const std::string_view data, const std::shared_ptr<void>& owner, const bool isPinned) :
+    _data(data),
+    _owner(owner),
+    _isPinned(isPinned)
+{
+}
+
+Storage::Slice::~Slice()
+{
+}
+
+std::string_view Storage::Slice::getData() const
+{
+    return _data;
+}
+
+size_t Storage::Slice::getSize() const
+{
+    return _data.size();
+}
+
+bool Storage::Slice::isPinned() const
+{
+    return _isPinned;
+}
+
+bool Storage::Backend::get(const KeyValue::Data& key, Slice& value) const
+{
+    bool isFound = false;
+
+    if (!get(key, value, isFound))
+    {
+        return false;
+    }
+
+    if (!isFound)
+    {
+        Logger::error("Can\'t get value (Not found)");
+        return false;
+    }
+
+    return true;
+}
+
+bool Storage::Backend::copy(const Backend& target, const KeyValue::Data& prefix, const KeyValue::Data& targetPrefix) const
+{
+    ReadOptions options;
+
+    options.fillCache = false;
+    options.readahead = SCAN_READAHEAD;
+
+    Cursor::Ptr cursor = scan(options);
+
+    if (!cursor)
+    {
+        return false;
+    }
+
+    Iterator it(std::move(cursor), prefix, "");
+    KeyValueList pairs;
+
+    for (; it.isValid(); it.next())
+    {
+        pairs.emplace_back(targetPrefix + it.getKey(), it.getValue());
+
+        if (pairs.size() >= COPY_BATCH_SIZE)
+        {
+            if (!target.write(pairs, {}, false))
+            {
+                return false;
+            }
+
+            pairs.clear();
+        }
+    }
+
+    if (!it.getStatus())
+    {
+        return false;
+    }
+
+    return target.write(pairs, {}, true);
+}
+
+Storage::Iterator::Iterator(Backend::Cursor::Ptr cursor, const KeyValue::Data& base, const KeyValue::Data& prefix) :
+    _cursor(std::move(cursor)),
+    _base(base),
+    _prefix(base + prefix)
+{
+    _cursor->seek(_prefix);
+}
+
+Storage::Iterator::~Iterator()
+{
+}
+
+void Storage::Iterator::seek(const KeyValue::Data& key)
+{
+    _cursor->seek(std::max(_base + key, _prefix));
+}
+
+void Storage::Iterator::next()
+{
+    _cursor->next();
+}
+
+void Storage::Iterator::prev()
+{
+    _cursor->prev();
+}
+
+bool Storage::Iterator::isValid() const
+{
+    return _cursor->isValid() && _cursor->getKey().starts_with(_prefix);
+}
+
+bool Storage::Iterator::getStatus() const
+{
+    return _cursor->getStatus();
+}
+
+Storage::KeyValue::Data Storage::Iterator::getKey() const
+{
+    return KeyValue::Data(_cursor->getKey().substr(_base.size()));
+}
+
+Storage::KeyValue::Data Storage::Iterator::getValue() const
+{
+    return KeyValue::Data(_cursor->getValue());
+}
+
+std::string_view Storage::Iterator::getValueView() const
+{
+    return _cursor->getValue();
+}
+
+Storage::ReadOptions::ReadOptions() :
+    fillCache(true),
+    readahead(0)
+{
+}
+
+Storage::Options::Options() :
+    backend(DISK),
+    syncInterval(SYNC_INTERVAL),
+    reclaimInterval(RECLAIM_INTERVAL),
+    reclaimRate(RECLAIM_RATE),
+    pruneInterval(PRUNE_INTERVAL),
+    archiveThreshold(ARCHIVE_THRESHOLD),
+    compression(static_cast<Compression>(COMPRESSION)),
+    compressionDictSize(COMPRESSION_DICT_SIZE),
+    blockCacheSize(BLOCK_CACHE_SIZE),
+    bloomBitsPerKey(BLOOM_BITS_PER_KEY),
+    writeBufferSize(WRITE_BUFFER_SIZE),
+    maxOpenFiles(MAX_OPEN_FILES)
+{
+}
+
+Storage::Storage(const std::string& path, const Options& options) :
     _path(path),
-    _db(nullptr)
+    _options(options),
+    _dirty(false),
+    _reads(0),
+    _bytesRead(0),
+    _bytesCopied(0)
+{
+}
+
+Storage::Storage(const Ptr& parent, const std::string& prefix) :
+    _path(parent->_path),
+    _options(parent->_options),
+    _parent(parent),
+    _prefix(prefix),
+    _dirty(false),
+    _reads(0),
+    _bytesRead(0),
+    _bytesCopied(0)
 {
 }
 
 Storage::~Storage()
 {
-    if (_db)
+    if (_backend && !_parent)
     {
-        delete _db;
+        sync();
+
+        _backend->close();
     }
 }
 
 bool Storage::create()
 {
-    if (_db)
+    if (_backend)
     {
         Logger::error("DB already open (Path: {})", _path);
         return false;
     }
 
-    DB::Options options;
+    if (_parent)
+    {
+        if (exists())
+        {
+            Logger::error("Can\'t create DB (Partition already exists)");
+            return false;
+        }
+
+        _backend = _parent->_backend;
 
-    options.create_if_missing = true;
-    options.error_if_exists = true;
-    options.paranoid_checks = true;
-    options.compression = DB::kNoCompression;
+        return true;
+    }
 
-    const DB::Status status = DB::DB::Open(options, _path, &_db);
+    const Backend::Ptr backend = makeBackend();
 
-    if (!status.ok())
+    if (!backend->create())
     {
-        Logger::error("Can\'t create DB ({})", status.ToString());
         return false;
     }
 
+    _backend = backend;
+
     return true;
 }
 
 bool Storage::open()
 {
-    if (_db)
+    if (_backend)
     {
         Logger::error("DB already open (Path: {})", _path);
         return false;
     }
 
-    DB::Options options;
+    if (_parent)
+    {
+        if (!exists())
+        {
+            Logger::error("Can\'t open DB (Partition does not exist)");
+            return false;
+        }
+
+        _backend = _parent->_backend;
 
-    options.paranoid_checks = true;
-    options.compression = DB::kNoCompression;
+        return true;
+    }
 
-    const DB::Status status = DB::DB::Open(options, _path, &_db);
+    const Backend::Ptr backend = makeBackend();
 
-    if (!status.ok())
+    if (!backend->open())
     {
-        Logger::error("Can\'t open DB ({})", status.ToString());
         return false;
     }
 
+    _backend = backend;
+
     return true;
 }
 
 bool Storage::close()
 {
-    if (!_db)
+    if (!_backend)
     {
         Logger::error("DB is not open (Path: {})", _path);
         return false;
     }
 
-    delete _db;
+    if (!_parent)
+    {
+        sync();
+
+        _backend->close();
+    }
 
-    _db = nullptr;
+    _backend = nullptr;
 
     return true;
 }
 
+bool Storage::isOpen() const
+{
+    return _backend != nullptr;
+}
+
+bool Storage::exists() const
+{
+    if (_parent)
+    {
+        const Iterator::Ptr it = _parent->scan(_prefix);
+
+        return it && it->isValid();
+    }
+
+    return makeBackend()->exists();
+}
+
 Storage::KeyValue::Ptr Storage::get(const KeyValue::Data& key) const
 {
-    if (!_db)
+    if (!_backend)
     {
         Logger::error("DB is not open (Path: {})", _path);
         return nullptr;
     }
 
-    DB::ReadOptions readOptions;
+    Slice value;
+
+    if (!_backend->get(_prefix + key, value))
+    {
+        return nullptr;
+    }
+
+    countRead(value.getSize(), value.isPinned() ? value.getSize() : value.getSize() * 2);
+
+    return std::make_shared<Storage::KeyValue>(key, KeyValue::Data(value.getData()));
+}
+
+bool Storage::get(const KeyValue::Data& key, Slice& value) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (!_backend->get(_prefix + key, value))
+    {
+        return false;
+    }
+
+    countRead(value.getSize(), value.isPinned() ? 0 : value.getSize());
 
-    readOptions.verify_checksums = true;
+    return true;
+}
 
-    std::string value;
+bool Storage::get(const KeyValue::Data& key, Slice& value, bool& isFound) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
 
-    const DB::Status status = _db->Get(readOptions, key, &value);
+    if (!_backend->get(_prefix + key, value, isFound))
+    {
+        return false;
+    }
 
-    if (!status.ok())
+    if (isFound)
     {
-        Logger::error("Can\'t get value ({})", status.ToString());
+        countRead(value.getSize(), value.isPinned() ? 0 : value.getSize());
+    }
+
+    return true;
+}
+
+bool Storage::multiGet(const KeyList& keys, std::vector<Slice>& values, StatusList& statuses) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (!_backend->multiGet(makeKeys(keys), values, statuses))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (statuses[i])
+        {
+            countRead(values[i].getSize(), values[i].isPinned() ? 0 : values[i].getSize());
+        }
+    }
+
+    return true;
+}
+
+Storage::Iterator::Ptr Storage::scan(const KeyValue::Data& prefix, const ReadOptions& options) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
         return nullptr;
     }
 
-    return std::make_shared<Storage::KeyValue>(key, value);
+    Backend::Cursor::Ptr cursor = _backend->scan(options);
+
+    if (!cursor)
+    {
+        return nullptr;
+    }
+
+    return std::make_shared<Storage::Iterator>(std::move(cursor), _prefix, prefix);
 }
 
-bool Storage::set(const KeyValueList& pairs) const
+bool Storage::set(const KeyValueList& pairs, const Durability durability) const
 {
-    if (!_db)
+    if (!_backend)
     {
         Logger::error("DB is not open (Path: {})", _path);
         return false;
     }
 
-    DB::WriteBatch batch;
+    if (_parent)
+    {
+        return _parent->set(makeKeys(pairs), durability);
+    }
 
-    for (const KeyValue& pair : pairs)
+    if (durability == PERIODIC || durability == ASYNC)
+    {
+        if (!write(pairs, {}, false))
+        {
+            return false;
+        }
+
+        if (durability == PERIODIC)
+        {
+            _dirty = true;
+        }
+
+        return true;
+    }
+
+    return write(pairs, {}, true);
+}
+
+bool Storage::replace(const KeyList& keys, const KeyValueList& pairs) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    return write(makeKeys(pairs), makeKeys(keys), true);
+}
+
+bool Storage::ingest(const KeyValueList& pairs) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (_parent)
+    {
+        return _parent->ingest(makeKeys(pairs));
+    }
+
+    KeyValueList sorted = pairs;
+
+    std::sort(sorted.begin(), sorted.end(), [](const KeyValue& a, const KeyValue& b) {
+        return a.getKey() < b.getKey();
+    });
+
+    return _backend->ingest(sorted);
+}
+
+bool Storage::checkpoint(const std::string& path) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    if (!_parent)
+    {
+        return _backend->checkpoint(path);
+    }
+
+    Storage target(path, _parent->_options);
+
+    if (!target.create())
+    {
+        return false;
+    }
+
+    const bool status = copy(target);
+
+    target.close();
+
+    return status;
+}
+
+bool Storage::copy(const Storage& target) const
+{
+    if (!_backend || !target._backend)
     {
-        batch.Put(pair.getKey(), pair.getValue());
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
     }
 
-    DB::WriteOptions writeOptions;
+    return _backend->copy(*target._backend, _prefix, target._prefix);
+}
+
+bool Storage::sync() const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
 
-    writeOptions.sync = true;
+    if (_parent)
+    {
+        return _parent->sync();
+    }
 
-    const DB::Status status = _db->Write(writeOptions, &batch);
+    if (!_dirty.exchange(false))
+    {
+        return true;
+    }
 
-    if (!status.ok())
+    if (!_backend->sync())
     {
-        Logger::error("Can\'t set value ({})", status.ToString());
+        _dirty = true;
         return false;
     }
 
     return true;
 }
 
+bool Storage::getApproximateSize(const KeyValue::Data& prefix, uint64_t& size) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    const std::string& start = _prefix + prefix;
+
+    return _backend->getApproximateSize(start, makeLimit(start), size);
+}
+
+bool Storage::compact(const KeyValue::Data& prefix) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    const std::string& start = _prefix + prefix;
+
+    return _backend->compact(start, makeLimit(start));
+}
+
+bool Storage::compact(const KeyValue::Data& start, const KeyValue::Data& limit) const
+{
+    if (!_backend)
+    {
+        Logger::error("DB is not open (Path: {})", _path);
+        return false;
+    }
+
+    return _backend->compact(_prefix + start, _prefix + limit);
+}
+
+Storage::ReadStats Storage::getReadStats() const
+{
+    if (_parent)
+    {
+        return _parent->getReadStats();
+    }
+
+    return {_reads, _bytesRead, _bytesCopied};
+}
+
 bool Storage::remove() const
 {
-    const DB::Status status = DB::DestroyDB(_path, DB::Options());
+    if (_parent)
+    {
+        const Iterator::Ptr it = _parent->scan(_prefix);
+
+        if (!it)
+        {
+            return false;
+        }
+
+        KeyList keys;
+
+        for (; it->isValid(); it->next())
+        {
+            keys.push_back(it->getKey());
+
+            if (keys.size() >= REMOVE_BATCH_SIZE)
+            {
+                if (!_parent->replace(keys, {}))
+                {
+                    return false;
+                }
+
+                keys.clear();
+            }
+        }
+
+        if (!it->getStatus())
+        {
+            return false;
+        }
+
+        return _parent->replace(keys, {});
+    }
+
+    return makeBackend()->remove();
+}
+
+bool Storage::reclaim(const uint64_t maxBytes, uint64_t& bytes, bool& isDone) const
+{
+    if (!_parent)
+    {
+        return makeBackend()->reclaim(maxBytes, bytes, isDone);
+    }
 
-    if (!status.ok())
+    const Iterator::Ptr it = _parent->scan(_prefix);
+
+    if (!it)
     {
-        Logger::error("Can\'t remove DB ({})", status.ToString());
         return false;
     }
 
+    KeyList keys;
+
+    for (; it->isValid() && bytes < maxBytes; it->next())
+    {
+        keys.push_back(it->getKey());
+
+        bytes += keys.back().size() + it->getValueView().size();
+
+        if (keys.size() >= REMOVE_BATCH_SIZE)
+        {
+            if (!_parent->replace(keys, {}))
+            {
+                return false;
+            }
+
+            keys.clear();
+        }
+    }
+
+    if (!it->getStatus())
+    {
+        return false;
+    }
+
+    isDone = !it->isValid();
+
+    return _parent->replace(keys, {});
+}
+
+bool Storage::removeFiles(const std::string& path, const uint64_t maxBytes, uint64_t& bytes, bool& isDone)
+{
+    std::error_code error;
+
+    isDone = false;
+
+    if (!std::filesystem::exists(path, error))
+    {
+        isDone = !error;
+        return isDone;
+    }
+
+    std::vector<std::filesystem::path> files;
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path, error))
+    {
+        files.push_back(entry.path());
+    }
+
+    if (error)
+    {
+        Logger::error("Can\'t read directory ({})", error.message());
+        return false;
+    }
+
+    for (const std::filesystem::path& file : files)
+    {
+        if (bytes >= maxBytes)
+        {
+            return true;
+        }
+
+        const uintmax_t size = std::filesystem::is_regular_file(file, error) ? std::filesystem::file_size(file, error) : 0;
+
+        if (!error)
+        {
+            std::filesystem::remove_all(file, error);
+        }
+
+        if (error)
+        {
+            Logger::error("Can\'t remove file ({})", error.message());
+            return false;
+        }
+
+        bytes += size;
+    }
+
+    std::filesystem::remove(path, error);
+
+    if (error)
+    {
+        Logger::error("Can\'t remove directory ({})", error.message());
+        return false;
+    }
+
+    isDone = true;
+
     return true;
+}
+
+std::shared_ptr<DB::Cache> Storage::makeBlockCache(const size_t size)
+{
+    if (!size)
+    {
+        return nullptr;
+    }
+
+#ifdef USE_ROCKSDB
+    return DB::NewLRUCache(size);
+#else
+    return std::shared_ptr<DB::Cache>(DB::NewLRUCache(size));
+#endif
+}
+
+std::shared_ptr<const DB::FilterPolicy> Storage::makeFilterPolicy(const size_t bitsPerKey)
+{
+    if (!bitsPerKey)
+    {
+        return nullptr;
+    }
+
+    return std::shared_ptr<const DB::FilterPolicy>(DB::NewBloomFilterPolicy(bitsPerKey));
+}
+
+Storage::Backend::Ptr Storage::makeBackend() const
+{
+    if (_options.backend == MEMORY)
+    {
+        return std::make_shared<MemoryBackend>(_path);
+    }
+
+    return std::make_shared<DiskBackend>(_path, _options);
+}
+
+bool Storage::write(const KeyValueList& pairs, const KeyList& keys, const bool sync) const
+{
+    return _backend->write(pairs, keys, sync);
+}
+
+void Storage::countRead(const size_t size, const size_t copied) const
+{
+    if (_parent)
+    {
+        return _parent->countRead(size, copied);
+    }
+
+    _reads++;
+    _bytesRead += size;
+    _bytesCopied += copied;
+}
+
+Storage::KeyValueList Storage::makeKeys(const KeyValueList& pairs) const
+{
+    if (_prefix.empty())
+    {
+        return pairs;
+    }
+
+    KeyValueList result;
+
+    result.reserve(pairs.size());
+
+    for (const KeyValue& pair : pairs)
+    {
+        result.emplace_back(_prefix + pair.getKey(), pair.getValue());
+    }
+
+    return result;
+}
+
+Storage::KeyList Storage::makeKeys(const KeyList& keys) const
+{
+    KeyList result;
+
+    result.reserve(keys.size());
+
+    for (const KeyValue::Data& key : keys)
+    {
+        result.push_back(_prefix + key);
+    }
+
+    return result;
+}
+
+Storage::KeyValue::Data Storage::makeLimit(const KeyValue::Data& prefix)
+{
+    KeyValue::Data limit = prefix;
+
+    while (!limit.empty() && static_cast<uint8_t>(limit.back()) == 0xff)
+    {
+        limit.pop_back();
+    }
+
+    if (!limit.empty())
+    {
+        limit.back()++;
+    }
+
+    return limit;
 }
\ No newline at end of file
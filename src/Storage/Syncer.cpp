@@ -0,0 +1,96 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <vector>
+
+#include "Storage/Syncer.h"
+#include "System/Logger.h"
+
+using namespace Core::Storage;
+
+Syncer::Syncer(const Cache& cache, const size_t interval) :
+    _cache(cache),
+    _interval(interval),
+    _isStopped(true)
+{
+}
+
+Syncer::~Syncer()
+{
+    stop();
+}
+
+void Syncer::start()
+{
+    if (!_interval.count() || _thread.joinable())
+    {
+        return;
+    }
+
+    _isStopped = false;
+
+    _thread = std::thread(&Syncer::process, this);
+}
+
+void Syncer::stop()
+{
+    if (!_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _isStopped = true;
+    }
+
+    _condition.notify_all();
+
+    _thread.join();
+}
+
+void Syncer::process()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_condition.wait_for(lock, _interval, [this]() { return _isStopped; }))
+    {
+        lock.unlock();
+
+        std::vector<Chain::Ptr> chains;
+
+        _cache.forEach([&chains](const Chain::Ptr& chain) {
+            chains.push_back(chain);
+        });
+
+        for (const Chain::Ptr& chain : chains)
+        {
+            if (!chain->sync())
+            {
+                Logger::error("Can\'t sync chain");
+            }
+        }
+
+        lock.lock();
+    }
+}
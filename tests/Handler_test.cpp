@@ -425,6 +425,473 @@ TEST_F(HandlerTest, GetBlock)
     }
 }
 
+TEST_F(HandlerTest, GetBlockByHash)
+{
+    Core::Storage::Manager manager(tempDirectory());
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_create_chain_request()->set_chain_id(1);
+        req.mutable_create_chain_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    std::string hash;
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_add_block_request()->set_chain_id(1);
+        req.mutable_add_block_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        hash = resp.add_block_response().block().hash();
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_block_by_hash_request()->set_chain_id(1);
+        req.mutable_get_block_by_hash_request()->set_hash(hash);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.get_block_by_hash_response().block().hash(), hash);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_block_by_hash_request()->set_chain_id(1);
+        req.mutable_get_block_by_hash_request()->set_hash("hash");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::DATA_ERROR);
+    }
+}
+
+TEST_F(HandlerTest, CloneChain)
+{
+    const std::string& path = tempDirectory();
+
+    Core::Storage::Manager manager(path);
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_create_chain_request()->set_chain_id(1);
+        req.mutable_create_chain_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_clone_chain_request()->set_chain_id(1);
+        req.mutable_clone_chain_request()->set_target_chain_id(2);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_chain_header_request()->set_chain_id(2);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.get_chain_header_response().header().data(), "data");
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_backup_chain_request()->set_chain_id(1);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::DATA_ERROR);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_backup_chain_request()->set_chain_id(1);
+        req.mutable_backup_chain_request()->set_path(path + "/backup");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::ERROR);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_backup_chain_request()->set_chain_id(1);
+        req.mutable_backup_chain_request()->set_path("backup");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+}
+
+TEST_F(HandlerTest, GetStats)
+{
+    Core::Storage::Storage::Options options;
+
+    options.reclaimInterval = 0;
+
+    Core::Storage::Manager manager(tempDirectory(), CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT, options);
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    EXPECT_TRUE(manager.createChain(1, "data"));
+    EXPECT_TRUE(manager.removeChain(1));
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_stats_request();
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.get_stats_response().pending_removals(), 1);
+        EXPECT_EQ(resp.get_stats_response().reclaimed_chains(), 0);
+    }
+}
+
+TEST_F(HandlerTest, ListChains)
+{
+    Core::Storage::Manager manager(tempDirectory());
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    for (size_t chainId = 1; chainId <= 3; chainId++)
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_create_chain_request()->set_chain_id(chainId);
+        req.mutable_create_chain_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_list_chains_request()->set_start_id(2);
+        req.mutable_list_chains_request()->set_max_count(1);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.list_chains_response().chains_size(), 1);
+        EXPECT_EQ(resp.list_chains_response().chains(0).chain_id(), 2);
+        EXPECT_EQ(resp.list_chains_response().next_id(), 3);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_list_chains_request();
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.list_chains_response().chains_size(), 3);
+        EXPECT_EQ(resp.list_chains_response().next_id(), 0);
+    }
+}
+
+TEST_F(HandlerTest, Chunks)
+{
+    Core::Storage::Manager manager(tempDirectory());
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_create_chain_request()->set_chain_id(1);
+        req.mutable_create_chain_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    const std::string data(MAX_CHUNK_LENGTH, 'x');
+    std::string hash;
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_upload_chunk_request()->set_chain_id(1);
+        req.mutable_upload_chunk_request()->set_data(data);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        hash = resp.upload_chunk_response().hash();
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_upload_chunk_request()->set_chain_id(1);
+        req.mutable_upload_chunk_request()->set_data(data + "x");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::DATA_ERROR);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_add_block_request()->set_chain_id(1);
+        req.mutable_add_block_request()->set_data("data");
+        req.mutable_add_block_request()->add_chunks(hash);
+        req.mutable_add_block_request()->add_chunks(hash);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.add_block_response().block().chunks_size(), 2);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_add_block_request()->set_chain_id(1);
+        req.mutable_add_block_request()->add_chunks("hash");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::DATA_ERROR);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_chunk_request()->set_chain_id(1);
+        req.mutable_get_chunk_request()->set_hash(hash);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.get_chunk_response().data(), data);
+    }
+}
+
+TEST_F(HandlerTest, ImportBlocks)
+{
+    Core::Storage::Manager manager(tempDirectory());
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_create_chain_request()->set_chain_id(1);
+        req.mutable_create_chain_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_import_blocks_request()->set_chain_id(1);
+
+        for (size_t i = 0; i < 16; i++)
+        {
+            req.mutable_import_blocks_request()->add_data("data");
+        }
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.import_blocks_response().index(), 16);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_verify_chain_request()->set_chain_id(1);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_import_blocks_request()->set_chain_id(1);
+        req.mutable_import_blocks_request()->add_data(std::string(MAX_DATA_LENGTH + 1, 'x'));
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::DATA_ERROR);
+    }
+}
+
+TEST_F(HandlerTest, GetBlocksByIndex)
+{
+    Core::Storage::Manager manager(tempDirectory());
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    std::vector<std::string> hashes;
+
+    for (size_t chainId = 1; chainId <= 2; chainId++)
+    {
+        {
+            Service::IPC::Request req;
+            Service::IPC::Response resp;
+
+            req.mutable_create_chain_request()->set_chain_id(chainId);
+            req.mutable_create_chain_request()->set_data("data");
+
+            EXPECT_TRUE(sendRequest(req, resp));
+
+            EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+        }
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            Service::IPC::Request req;
+            Service::IPC::Response resp;
+
+            req.mutable_add_block_request()->set_chain_id(chainId);
+            req.mutable_add_block_request()->set_data("data");
+
+            EXPECT_TRUE(sendRequest(req, resp));
+
+            EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+            hashes.push_back(resp.add_block_response().block().hash());
+        }
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        for (const auto& [chainId, index] : std::vector<std::pair<size_t, size_t>>({{2, 3}, {1, 1}, {3, 1}, {1, 4}}))
+        {
+            Service::IPC::BlockIndex* item = req.mutable_get_blocks_by_index_request()->add_items();
+
+            item->set_chain_id(chainId);
+            item->set_index(index);
+        }
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        const Service::IPC::GetBlocksByIndexResponse& result = resp.get_blocks_by_index_response();
+
+        EXPECT_EQ(result.results_size(), 4);
+
+        EXPECT_EQ(result.results(0).status(), Core::Handler::SUCCESS);
+        EXPECT_EQ(result.results(1).status(), Core::Handler::SUCCESS);
+        EXPECT_EQ(result.results(2).status(), Core::Handler::ERROR);
+        EXPECT_EQ(result.results(3).status(), Core::Handler::ERROR);
+
+        EXPECT_EQ(result.results(0).block().hash(), hashes[5]);
+        EXPECT_EQ(result.results(1).block().hash(), hashes[0]);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        for (size_t i = 0; i <= GET_BLOCKS_MAX_COUNT; i++)
+        {
+            req.mutable_get_blocks_by_index_request()->add_items()->set_index(i);
+        }
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::DATA_ERROR);
+    }
+}
+
 TEST_F(HandlerTest, GetBlocks)
 {
     Core::Storage::Manager manager(tempDirectory());
@@ -476,6 +943,25 @@ TEST_F(HandlerTest, GetBlocks)
         EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
 
         EXPECT_EQ(resp.get_blocks_response().blocks_size(), 8);
+        EXPECT_EQ(resp.get_blocks_response().next_index(), 0);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_blocks_request()->set_chain_id(1);
+        req.mutable_get_blocks_request()->set_max_count(3);
+        req.mutable_get_blocks_request()->set_reverse(true);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.get_blocks_response().blocks_size(), 3);
+        EXPECT_EQ(resp.get_blocks_response().next_index(), 5);
     }
 }
 
@@ -544,6 +1030,85 @@ TEST_F(HandlerTest, VerifyChain)
     }
 }
 
+TEST_F(HandlerTest, SetRetention)
+{
+    Core::Storage::Manager manager(tempDirectory());
+    Core::Handler handler(manager);
+
+    startServer(handler);
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_create_chain_request()->set_chain_id(1);
+        req.mutable_create_chain_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_add_block_request()->set_chain_id(1);
+        req.mutable_add_block_request()->set_data("data");
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_TRUE(resp.add_block_response().block().timestamp());
+        EXPECT_FALSE(resp.add_block_response().block().pruned());
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_set_retention_request()->set_chain_id(1);
+        req.mutable_set_retention_request()->set_retain_blocks(2);
+        req.mutable_set_retention_request()->set_retain_age(3600);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_get_chain_info_request()->set_chain_id(1);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::SUCCESS);
+
+        EXPECT_EQ(resp.get_chain_info_response().retain_blocks(), 2);
+        EXPECT_EQ(resp.get_chain_info_response().retain_age(), 3600);
+    }
+
+    {
+        Service::IPC::Request req;
+        Service::IPC::Response resp;
+
+        req.mutable_set_retention_request()->set_chain_id(2);
+        req.mutable_set_retention_request()->set_retain_blocks(2);
+
+        EXPECT_TRUE(sendRequest(req, resp));
+
+        EXPECT_TRUE(resp.has_status());
+
+        EXPECT_EQ(resp.status().status(), Core::Handler::ERROR);
+    }
+}
+
 TEST_F(HandlerTest, GetChainHeader)
 {
     Core::Storage::Manager manager(tempDirectory());
@@ -0,0 +1,222 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+
+#include <filesystem>
+#include <fstream>
+
+#include "BaseTest.h"
+
+#include "Storage/Archive.h"
+
+class ArchiveTest : public BaseTest
+{
+protected:
+    Core::Storage::Archive::DataList makeRecords(const size_t first, const size_t count) const
+    {
+        Core::Storage::Archive::DataList records;
+
+        for (size_t i = first; i < first + count; i++)
+        {
+            records.push_back("Record " + std::to_string(i));
+        }
+
+        return records;
+    }
+};
+
+TEST_F(ArchiveTest, Append)
+{
+    const std::string& path = makeTempPath();
+
+    {
+        Core::Storage::Archive archive(path, 64);
+
+        EXPECT_TRUE(archive.open());
+        EXPECT_EQ(archive.size(), 0);
+
+        EXPECT_FALSE(archive.append(2, makeRecords(2, 10)));
+
+        EXPECT_TRUE(archive.append(1, makeRecords(1, 100)));
+        EXPECT_TRUE(archive.append(101, makeRecords(101, 50)));
+
+        EXPECT_EQ(archive.size(), 150);
+        EXPECT_GT(archive.getDataSize(), 0);
+        EXPECT_GT(archive.getStorageSize(), 0);
+
+        EXPECT_TRUE(archive.close());
+    }
+
+    Core::Storage::Archive archive(path, 64);
+
+    EXPECT_TRUE(archive.open());
+    EXPECT_EQ(archive.size(), 150);
+
+    for (size_t i = 150; i > 0; i--)
+    {
+        Core::Storage::Archive::Data data;
+
+        EXPECT_TRUE(archive.get(i, data));
+        EXPECT_EQ(data, "Record " + std::to_string(i));
+    }
+
+    Core::Storage::Archive::Data data;
+
+    EXPECT_FALSE(archive.get(0, data));
+    EXPECT_FALSE(archive.get(151, data));
+
+    EXPECT_TRUE(archive.close());
+
+    EXPECT_TRUE(archive.remove());
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(ArchiveTest, PreparePublish)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Archive archive(path, 64);
+
+    EXPECT_TRUE(archive.open());
+
+    std::string tmpPath1;
+    std::string tmpPath2;
+
+    EXPECT_TRUE(archive.prepare(1, makeRecords(1, 10), tmpPath1));
+
+    EXPECT_TRUE(std::filesystem::exists(tmpPath1));
+    EXPECT_EQ(archive.size(), 0);
+
+    EXPECT_TRUE(archive.publish(1, tmpPath1));
+    EXPECT_EQ(archive.size(), 10);
+
+    EXPECT_TRUE(archive.prepare(1, makeRecords(1, 10), tmpPath2));
+    EXPECT_TRUE(std::filesystem::exists(tmpPath2));
+
+    EXPECT_FALSE(archive.publish(1, tmpPath2));
+    EXPECT_FALSE(std::filesystem::exists(tmpPath2));
+    EXPECT_EQ(archive.size(), 10);
+
+    Core::Storage::Archive::Data data;
+
+    EXPECT_TRUE(archive.get(10, data));
+    EXPECT_EQ(data, "Record 10");
+
+    EXPECT_TRUE(archive.close());
+    EXPECT_TRUE(archive.remove());
+}
+
+TEST_F(ArchiveTest, Truncate)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Archive archive(path);
+
+    EXPECT_TRUE(archive.open());
+
+    EXPECT_TRUE(archive.append(1, makeRecords(1, 10)));
+    EXPECT_TRUE(archive.append(11, makeRecords(11, 10)));
+
+    EXPECT_FALSE(archive.truncate(15));
+    EXPECT_FALSE(archive.truncate(30));
+
+    EXPECT_TRUE(archive.truncate(10));
+    EXPECT_EQ(archive.size(), 10);
+
+    Core::Storage::Archive::Data data;
+
+    EXPECT_FALSE(archive.get(11, data));
+
+    EXPECT_TRUE(archive.append(11, makeRecords(11, 5)));
+    EXPECT_TRUE(archive.get(15, data));
+    EXPECT_EQ(data, "Record 15");
+
+    EXPECT_TRUE(archive.close());
+    EXPECT_TRUE(archive.open());
+    EXPECT_EQ(archive.size(), 15);
+    EXPECT_TRUE(archive.close());
+
+    EXPECT_TRUE(archive.remove());
+}
+
+TEST_F(ArchiveTest, Corrupted)
+{
+    const std::string& path = makeTempPath();
+
+    {
+        Core::Storage::Archive archive(path);
+
+        EXPECT_TRUE(archive.open());
+        EXPECT_TRUE(archive.append(1, makeRecords(1, 10)));
+        EXPECT_TRUE(archive.close());
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(path))
+    {
+        std::ofstream file(entry.path(), std::ios::binary | std::ios::app);
+
+        file << "Trailing data";
+    }
+
+    Core::Storage::Archive archive(path);
+
+    EXPECT_FALSE(archive.open());
+
+    EXPECT_TRUE(archive.remove());
+}
+
+TEST_F(ArchiveTest, Checkpoint)
+{
+    const std::string& path = makeTempPath();
+    const std::string& checkpointPath = makeTempPath();
+
+    Core::Storage::Archive archive(path);
+
+    EXPECT_TRUE(archive.open());
+    EXPECT_TRUE(archive.append(1, makeRecords(1, 10)));
+    EXPECT_TRUE(archive.append(11, makeRecords(11, 10)));
+
+    EXPECT_TRUE(archive.checkpoint(checkpointPath));
+    EXPECT_FALSE(archive.checkpoint(checkpointPath));
+
+    {
+        Core::Storage::Archive checkpoint(checkpointPath);
+
+        EXPECT_TRUE(checkpoint.open());
+        EXPECT_EQ(checkpoint.size(), 20);
+
+        EXPECT_TRUE(checkpoint.truncate(10));
+        EXPECT_TRUE(checkpoint.close());
+    }
+
+    EXPECT_EQ(archive.size(), 20);
+
+    Core::Storage::Archive::Data data;
+
+    EXPECT_TRUE(archive.get(20, data));
+    EXPECT_EQ(data, "Record 20");
+
+    EXPECT_TRUE(archive.close());
+
+    EXPECT_TRUE(archive.remove());
+    EXPECT_TRUE(Core::Storage::Archive(checkpointPath).remove());
+}
@@ -22,6 +22,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdio>
+
 #include "Storage/Block.h"
 #include "Crypto/SHA256.h"
 #include "Crypto/ECDSA.h"
@@ -175,4 +178,175 @@ TEST(Block, Unpack)
     EXPECT_EQ(container2->getData(), data.data());
 
     EXPECT_EQ(memcmp(container2->getSignature()->data(), signature->data(), container2->getSignature()->length()), 0);
+}
+
+TEST(Block, Chunks)
+{
+    const Core::Crypto::SHA256::Hash::Ptr hash = Core::Crypto::SHA256::getHash({"Hash 1"});
+
+    EXPECT_TRUE(hash);
+
+    const Core::Storage::Block::Container::Nonce::Ptr nonce = Core::Storage::Block::generateNonce();
+
+    EXPECT_TRUE(nonce);
+
+    Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::Signature::Ptr signature = secp256k1.getSignature(hash, secp256k1.generatePrivateKey());
+
+    EXPECT_TRUE(signature);
+
+    const Core::Storage::Block::Container::ChunkList chunks = {
+        Core::Crypto::SHA256::getHash({"Chunk 1"}),
+        Core::Crypto::SHA256::getHash({"Chunk 2"})
+    };
+
+    EXPECT_EQ(Core::Storage::Block::Container::encodeChunks({}), "");
+    EXPECT_EQ(Core::Storage::Block::Container::encodeChunks(chunks).size(), 8 + 2 * hash->length());
+
+    const Core::Storage::Block::Container::Ptr container1 = std::make_shared<Core::Storage::Block::Container>(
+        hash,
+        hash,
+        nonce,
+        "",
+        signature,
+        chunks);
+
+    Core::Storage::Block::Container::Data buffer;
+
+    EXPECT_TRUE(Core::Storage::Block::Container::pack(container1, buffer));
+
+    const Core::Storage::Block::Container::Ptr container2 = Core::Storage::Block::Container::unpack(buffer);
+
+    EXPECT_TRUE(container2);
+
+    EXPECT_EQ(container2->getChunks().size(), 2);
+
+    EXPECT_EQ(memcmp(container2->getChunks()[1]->data(), chunks[1]->data(), chunks[1]->length()), 0);
+}
+
+TEST(Block, Layout)
+{
+    const Core::Crypto::SHA256::Hash::Ptr hash = Core::Crypto::SHA256::getHash({"Hash 1"});
+
+    const Core::Storage::Block::Container::Nonce::Ptr nonce = Core::Storage::Block::generateNonce();
+
+    Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::Signature::Ptr signature = secp256k1.getSignature(hash, secp256k1.generatePrivateKey());
+
+    EXPECT_TRUE(signature);
+
+    const Core::Storage::Block::Container::Ptr container1 = std::make_shared<Core::Storage::Block::Container>(
+        hash,
+        hash,
+        nonce,
+        "You can\'t steer a parked car",
+        signature,
+        Core::Storage::Block::Container::ChunkList({Core::Crypto::SHA256::getHash({"Chunk 1"})}),
+        Core::Crypto::SHA256::getHash({"Payload"}),
+        1234567890,
+        true);
+
+    Core::Storage::Block::Container::Data buffer;
+    Core::Storage::Block::Container::Data message;
+
+    EXPECT_TRUE(Core::Storage::Block::Container::pack(container1, buffer));
+    EXPECT_TRUE(Core::Storage::Block::Container::packMessage(container1, message));
+
+    EXPECT_EQ(buffer[0], 0);
+    EXPECT_NE(message[0], 0);
+
+    for (const Core::Storage::Block::Container::Data& data : {buffer, message})
+    {
+        const Core::Storage::Block::Container::Ptr container2 = Core::Storage::Block::Container::unpack(data);
+
+        EXPECT_TRUE(container2);
+
+        EXPECT_EQ(memcmp(container2->getHash()->data(), hash->data(), hash->length()), 0);
+        EXPECT_EQ(memcmp(container2->getNonce()->data(), nonce->data(), nonce->length()), 0);
+        EXPECT_EQ(memcmp(container2->getSignature()->data(), signature->data(), signature->length()), 0);
+        EXPECT_EQ(container2->getData(), container1->getData());
+        EXPECT_EQ(container2->getChunks().size(), 1);
+        EXPECT_EQ(memcmp(container2->getPayloadHash()->data(), container1->getPayloadHash()->data(), hash->length()), 0);
+        EXPECT_EQ(container2->getTimestamp(), 1234567890);
+        EXPECT_TRUE(container2->isPruned());
+    }
+
+    for (size_t i = 1; i < buffer.size() - container1->getData().size(); i++)
+    {
+        Core::Storage::Block::Container::Data data = buffer;
+
+        data[i] ^= 0x01;
+
+        EXPECT_FALSE(Core::Storage::Block::Container::unpack(data));
+    }
+
+    EXPECT_FALSE(Core::Storage::Block::Container::unpack(buffer.substr(0, buffer.size() - 1)));
+    EXPECT_FALSE(Core::Storage::Block::Container::unpack(buffer + "x"));
+}
+
+TEST(Block, DISABLED_Benchmark)
+{
+    const Core::Crypto::SHA256::Hash::Ptr hash = Core::Crypto::SHA256::getHash({"Hash 1"});
+
+    Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::Signature::Ptr signature = secp256k1.getSignature(hash, secp256k1.generatePrivateKey());
+
+    const size_t count = 100000;
+
+    const auto measure = [](const size_t count, const auto& func)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_TRUE(func());
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime).count() / count;
+    };
+
+    for (const size_t size : {32, 1024, 16384})
+    {
+        const Core::Storage::Block::Container::Ptr container = std::make_shared<Core::Storage::Block::Container>(
+            hash,
+            hash,
+            Core::Storage::Block::generateNonce(),
+            Core::Storage::Block::Container::Data(size, 'x'),
+            signature,
+            Core::Storage::Block::Container::ChunkList(),
+            nullptr,
+            1234567890);
+
+        Core::Storage::Block::Container::Data buffer;
+        Core::Storage::Block::Container::Data message;
+
+        const auto packTime = measure(count, [&]() {
+            return Core::Storage::Block::Container::pack(container, buffer);
+        });
+
+        const auto packMessageTime = measure(count, [&]() {
+            return Core::Storage::Block::Container::packMessage(container, message);
+        });
+
+        const auto unpackTime = measure(count, [&]() {
+            return Core::Storage::Block::Container::unpack(buffer) != nullptr;
+        });
+
+        const auto unpackMessageTime = measure(count, [&]() {
+            return Core::Storage::Block::Container::unpackMessage(message) != nullptr;
+        });
+
+        std::printf("Payload %zu bytes: pack %lld ns (protobuf %lld ns), unpack %lld ns (protobuf %lld ns), size %zu (protobuf %zu)\n",
+            size,
+            static_cast<long long>(packTime),
+            static_cast<long long>(packMessageTime),
+            static_cast<long long>(unpackTime),
+            static_cast<long long>(unpackMessageTime),
+            buffer.size(),
+            message.size());
+    }
 }
\ No newline at end of file
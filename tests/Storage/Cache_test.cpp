@@ -0,0 +1,232 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "BaseTest.h"
+
+#include "Storage/Cache.h"
+#include "Storage/Chain.h"
+#include "Crypto/ECDSA.h"
+
+class CacheTest : public BaseTest
+{
+public:
+    Core::Storage::Chain::Ptr createChain(const std::string& path) const
+    {
+        const Core::Crypto::Secp256k1 secp256k1;
+
+        const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+        EXPECT_TRUE(privateKey);
+
+        const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+        EXPECT_TRUE(publicKey);
+
+        const Core::Storage::Chain::Ptr chain = std::make_shared<Core::Storage::Chain>(path);
+
+        EXPECT_TRUE(chain->create("You can\'t steer a parked car", privateKey, publicKey));
+        EXPECT_TRUE(chain->open());
+
+        return chain;
+    }
+};
+
+TEST_F(CacheTest, Get)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Cache cache(4, 0);
+
+    size_t loads = 0;
+
+    const Core::Storage::Cache::Loader loader = [&]() {
+        loads++;
+        return createChain(path + "/" + std::to_string(loads));
+    };
+
+    const Core::Storage::Chain::Ptr chain1 = cache.get(1, loader);
+
+    EXPECT_TRUE(chain1);
+    EXPECT_TRUE(chain1->isOpen());
+
+    const Core::Storage::Chain::Ptr chain2 = cache.get(1, loader);
+
+    EXPECT_EQ(chain1, chain2);
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(cache.size(), 1);
+
+    EXPECT_FALSE(cache.get(2, []() { return nullptr; }));
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.clear();
+
+    EXPECT_EQ(cache.size(), 0);
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CacheTest, Evict)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Cache cache(2, 0);
+
+    for (size_t i = 1; i <= 4; i++)
+    {
+        EXPECT_TRUE(cache.get(i, [&]() { return createChain(path + "/" + std::to_string(i)); }));
+    }
+
+    EXPECT_EQ(cache.size(), 2);
+
+    EXPECT_FALSE(cache.get(1, []() { return nullptr; }));
+    EXPECT_FALSE(cache.get(2, []() { return nullptr; }));
+    EXPECT_TRUE(cache.get(3, []() { return nullptr; }));
+    EXPECT_TRUE(cache.get(4, []() { return nullptr; }));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CacheTest, Evictor)
+{
+    const std::string& path = createTempDirectory();
+
+    std::vector<size_t> chainIds;
+
+    Core::Storage::Cache cache(2, 0, [&](const Core::Storage::Cache::ChainList& chains) {
+        for (const auto& [chainId, chain] : chains)
+        {
+            EXPECT_TRUE(chain->isOpen());
+
+            chainIds.push_back(chainId);
+        }
+    });
+
+    for (size_t i = 1; i <= 3; i++)
+    {
+        EXPECT_TRUE(cache.get(i, [&]() { return createChain(path + "/" + std::to_string(i)); }));
+    }
+
+    EXPECT_EQ(chainIds, std::vector<size_t>({1}));
+
+    cache.clear();
+
+    EXPECT_EQ(chainIds.size(), 3);
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CacheTest, EvictInUse)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Cache cache(1, 0);
+
+    const Core::Storage::Chain::Ptr chain = cache.get(1, [&]() { return createChain(path + "/1"); });
+
+    EXPECT_TRUE(chain);
+
+    EXPECT_TRUE(cache.get(2, [&]() { return createChain(path + "/2"); }));
+
+    EXPECT_EQ(cache.get(1, []() { return nullptr; }), chain);
+    EXPECT_EQ(cache.size(), 1);
+
+    EXPECT_FALSE(cache.get(2, []() { return nullptr; }));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CacheTest, EvictIdle)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Cache cache(8, 1);
+
+    EXPECT_TRUE(cache.get(1, [&]() { return createChain(path + "/1"); }));
+
+    waitSec(1);
+
+    EXPECT_TRUE(cache.get(2, [&]() { return createChain(path + "/2"); }));
+
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_FALSE(cache.get(1, []() { return nullptr; }));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CacheTest, Remove)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Cache cache(4, 0);
+
+    EXPECT_TRUE(cache.get(1, [&]() { return createChain(path + "/1"); }));
+
+    cache.remove(1);
+    cache.remove(2);
+
+    EXPECT_EQ(cache.size(), 0);
+
+    EXPECT_TRUE(Core::Storage::Chain(path + "/1").remove());
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CacheTest, LoadConcurrently)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Cache cache(4, 0);
+
+    std::promise<void> isReleased;
+    std::shared_future<void> released = isReleased.get_future().share();
+
+    std::atomic<size_t> loads = 0;
+
+    const Core::Storage::Cache::Loader slowLoader = [&]() {
+        loads++;
+        released.wait();
+        return createChain(path + "/1");
+    };
+
+    std::thread thread1([&]() { EXPECT_TRUE(cache.get(1, slowLoader)); });
+    std::thread thread2([&]() { EXPECT_TRUE(cache.get(1, slowLoader)); });
+
+    // Other chains are served while chain 1 is still opening
+    EXPECT_TRUE(cache.get(2, [&]() { return createChain(path + "/2"); }));
+
+    isReleased.set_value();
+
+    thread1.join();
+    thread2.join();
+
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(cache.size(), 2);
+
+    EXPECT_TRUE(removeDirectory(path));
+}
@@ -0,0 +1,105 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include "BaseTest.h"
+
+#include "Storage/Catalog.h"
+
+class CatalogTest : public BaseTest
+{
+};
+
+TEST_F(CatalogTest, AddChain)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Catalog catalog(path + "/catalog");
+
+    EXPECT_FALSE(catalog.exists());
+    EXPECT_TRUE(catalog.create());
+    EXPECT_TRUE(catalog.exists());
+
+    EXPECT_FALSE(catalog.hasChain(1));
+
+    EXPECT_TRUE(catalog.addChain({1, 0, 1000, 0, 0}));
+    EXPECT_TRUE(catalog.hasChain(1));
+
+    EXPECT_TRUE(catalog.updateChains({{1, 0, 0, 10, 100}, {2, 0, 0, 20, 200}}));
+    EXPECT_FALSE(catalog.hasChain(2));
+
+    Core::Storage::Catalog::Entry entry;
+
+    EXPECT_TRUE(catalog.getChain(1, entry));
+    EXPECT_EQ(entry.chainId, 1);
+    EXPECT_EQ(entry.createdAt, 1000);
+    EXPECT_EQ(entry.index, 10);
+    EXPECT_EQ(entry.dataSize, 100);
+
+    EXPECT_FALSE(catalog.getChain(2, entry));
+
+    EXPECT_TRUE(catalog.removeChain(1));
+    EXPECT_FALSE(catalog.hasChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(CatalogTest, GetChains)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Catalog catalog(path + "/catalog");
+
+    EXPECT_TRUE(catalog.create());
+
+    for (size_t chainId : {100, 2, 30, 1, 20})
+    {
+        EXPECT_TRUE(catalog.addChain({chainId, 1, 0, chainId, 0}));
+    }
+
+    Core::Storage::Catalog::EntryList entries;
+    size_t nextId = 0;
+
+    EXPECT_TRUE(catalog.getChains(0, 3, entries, nextId));
+    EXPECT_EQ(entries.size(), 3);
+    EXPECT_EQ(entries[0].chainId, 1);
+    EXPECT_EQ(entries[1].chainId, 2);
+    EXPECT_EQ(entries[2].chainId, 20);
+    EXPECT_EQ(entries[2].layout, 1);
+    EXPECT_EQ(nextId, 30);
+
+    entries.clear();
+
+    EXPECT_TRUE(catalog.getChains(nextId, 3, entries, nextId));
+    EXPECT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[1].chainId, 100);
+    EXPECT_EQ(entries[1].index, 100);
+    EXPECT_EQ(nextId, 0);
+
+    entries.clear();
+
+    EXPECT_TRUE(catalog.getChains(101, 3, entries, nextId));
+    EXPECT_TRUE(entries.empty());
+
+    EXPECT_TRUE(removeDirectory(path));
+}
@@ -22,20 +22,25 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #include "BaseTest.h"
 
 #include "Storage/Chain.h"
 #include "Storage/Block.h"
+#include "Storage/Storage.h"
+#include "Storage/Protocol.h"
+#include "Storage/Encoding.h"
 #include "Crypto/ECDSA.h"
 
 class ChainTest : public BaseTest
 {
 public:
-    Core::Storage::Block::Ptr getBlock() const
+    Core::Storage::Block::Ptr getBlock(const std::string& hash = "Hash 1") const
     {
         const Core::Storage::Block::Container::Data& data = "You can\'t steer a parked car";
 
-        const Core::Crypto::SHA256::Hash::Ptr hash1 = Core::Crypto::SHA256::getHash({"Hash 1"});
+        const Core::Crypto::SHA256::Hash::Ptr hash1 = Core::Crypto::SHA256::getHash({hash});
 
         EXPECT_TRUE(hash1);
 
@@ -279,6 +284,384 @@ TEST_F(ChainTest, GetBlocks)
     EXPECT_TRUE(chain.remove());
 }
 
+TEST_F(ChainTest, GetBlocksRange)
+{
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    const Core::Storage::Chain chain(makeTempPath());
+
+    EXPECT_TRUE(chain.create("You can\'t steer a parked car", privateKey, publicKey));
+
+    std::vector<Core::Storage::Block::Ptr> addedBlocks;
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        const Core::Storage::Block::Ptr block = getBlock();
+
+        EXPECT_TRUE(block);
+
+        EXPECT_TRUE(chain.addBlock(block));
+
+        addedBlocks.push_back(block);
+    }
+
+    const auto isSameBlock = [](const Core::Storage::Block::Ptr block1, const Core::Storage::Block::Ptr block2) {
+        return memcmp(block1->getData()->getHash()->data(),
+            block2->getData()->getHash()->data(),
+            block1->getData()->getHash()->length()) == 0;
+    };
+
+    {
+        std::vector<Core::Storage::Block::Ptr> blocks;
+        size_t nextIndex = 0;
+
+        EXPECT_TRUE(chain.getBlocks(0, 4, 1 << 20, false, blocks, nextIndex));
+
+        EXPECT_EQ(blocks.size(), 4);
+        EXPECT_EQ(nextIndex, 5);
+
+        EXPECT_TRUE(chain.getBlocks(nextIndex, 4, 1 << 20, false, blocks, nextIndex));
+        EXPECT_TRUE(chain.getBlocks(nextIndex, 4, 1 << 20, false, blocks, nextIndex));
+
+        EXPECT_EQ(blocks.size(), 10);
+        EXPECT_EQ(nextIndex, 0);
+
+        for (size_t i = 0; i < blocks.size(); i++)
+        {
+            EXPECT_TRUE(isSameBlock(blocks[i], addedBlocks[i]));
+        }
+    }
+
+    {
+        std::vector<Core::Storage::Block::Ptr> blocks;
+        size_t nextIndex = 0;
+
+        EXPECT_TRUE(chain.getBlocks(0, 3, 1 << 20, true, blocks, nextIndex));
+
+        EXPECT_EQ(blocks.size(), 3);
+        EXPECT_EQ(nextIndex, 7);
+
+        EXPECT_TRUE(isSameBlock(blocks[0], addedBlocks[9]));
+        EXPECT_TRUE(isSameBlock(blocks[2], addedBlocks[7]));
+
+        EXPECT_TRUE(chain.getBlocks(2, 3, 1 << 20, true, blocks, nextIndex));
+
+        EXPECT_EQ(blocks.size(), 5);
+        EXPECT_EQ(nextIndex, 0);
+
+        EXPECT_TRUE(isSameBlock(blocks[4], addedBlocks[0]));
+    }
+
+    {
+        std::vector<Core::Storage::Block::Ptr> blocks;
+        size_t nextIndex = 0;
+
+        EXPECT_TRUE(chain.getBlocks(3, 10, 1, false, blocks, nextIndex));
+
+        EXPECT_EQ(blocks.size(), 1);
+        EXPECT_EQ(nextIndex, 4);
+
+        EXPECT_TRUE(isSameBlock(blocks[0], addedBlocks[2]));
+    }
+
+    {
+        std::vector<Core::Storage::Block::Ptr> blocks;
+        size_t nextIndex = 0;
+
+        EXPECT_TRUE(chain.getBlocks(11, 10, 1 << 20, false, blocks, nextIndex));
+
+        EXPECT_TRUE(blocks.empty());
+        EXPECT_EQ(nextIndex, 0);
+    }
+
+    EXPECT_TRUE(chain.remove());
+}
+
+TEST_F(ChainTest, GetBlockByHash)
+{
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    for (const Core::Storage::Chain::Engine engine : {Core::Storage::Chain::STORAGE, Core::Storage::Chain::LOG})
+    {
+        const std::string& path = makeTempPath();
+
+        const Core::Storage::Chain chain(path);
+
+        EXPECT_TRUE(chain.create("You can\'t steer a parked car",
+            privateKey,
+            publicKey,
+            Core::Storage::Storage::SYNC,
+            engine));
+
+        std::vector<Core::Storage::Block::Ptr> addedBlocks;
+
+        for (size_t i = 0; i < 5; i++)
+        {
+            const Core::Storage::Block::Ptr block = getBlock("Hash " + std::to_string(i));
+
+            EXPECT_TRUE(block);
+
+            EXPECT_TRUE(chain.addBlock(block));
+
+            addedBlocks.push_back(block);
+        }
+
+        for (const Core::Storage::Block::Ptr& addedBlock : addedBlocks)
+        {
+            const Core::Crypto::SHA256::Hash::Ptr hash = addedBlock->getData()->getHash();
+
+            const Core::Storage::Block::Ptr block = chain.getBlockByHash(
+                std::string(reinterpret_cast<const char*>(hash->data()), hash->length()));
+
+            EXPECT_TRUE(block);
+
+            EXPECT_EQ(memcmp(block->getData()->getNonce()->data(),
+                addedBlock->getData()->getNonce()->data(),
+                block->getData()->getNonce()->length()), 0);
+        }
+
+        EXPECT_FALSE(chain.getBlockByHash(std::string(32, '\0')));
+
+        {
+            Core::Storage::Storage storage(path);
+
+            EXPECT_TRUE(storage.open());
+            EXPECT_TRUE(storage.set({{Core::Storage::DB_HASH_KEY + std::string(32, 'x'), Core::Storage::Encoding::encodeUInt64(1)}}));
+            EXPECT_TRUE(storage.close());
+        }
+
+        EXPECT_FALSE(chain.getBlockByHash(std::string(32, 'x')));
+
+        EXPECT_TRUE(chain.remove());
+    }
+}
+
+TEST_F(ChainTest, GetBlocksByIndex)
+{
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    for (const Core::Storage::Chain::Engine engine : {Core::Storage::Chain::STORAGE, Core::Storage::Chain::LOG})
+    {
+        const Core::Storage::Chain chain(makeTempPath());
+
+        EXPECT_TRUE(chain.create("You can\'t steer a parked car",
+            privateKey,
+            publicKey,
+            Core::Storage::Storage::SYNC,
+            engine));
+
+        std::vector<Core::Storage::Block::Ptr> addedBlocks;
+
+        for (size_t i = 0; i < 5; i++)
+        {
+            const Core::Storage::Block::Ptr block = getBlock("Hash " + std::to_string(i));
+
+            EXPECT_TRUE(block);
+
+            EXPECT_TRUE(chain.addBlock(block));
+
+            addedBlocks.push_back(block);
+        }
+
+        std::vector<Core::Storage::Block::Ptr> blocks;
+
+        EXPECT_TRUE(chain.getBlocks({4, 0, 1, 6, 4}, blocks));
+
+        EXPECT_EQ(blocks.size(), 5);
+
+        EXPECT_TRUE(blocks[0]);
+        EXPECT_FALSE(blocks[1]);
+        EXPECT_TRUE(blocks[2]);
+        EXPECT_FALSE(blocks[3]);
+        EXPECT_TRUE(blocks[4]);
+
+        EXPECT_EQ(memcmp(blocks[0]->getData()->getHash()->data(),
+            addedBlocks[3]->getData()->getHash()->data(),
+            blocks[0]->getData()->getHash()->length()), 0);
+
+        EXPECT_EQ(memcmp(blocks[2]->getData()->getHash()->data(),
+            addedBlocks[0]->getData()->getHash()->data(),
+            blocks[2]->getData()->getHash()->length()), 0);
+
+        EXPECT_EQ(memcmp(blocks[4]->getData()->getHash()->data(),
+            addedBlocks[3]->getData()->getHash()->data(),
+            blocks[4]->getData()->getHash()->length()), 0);
+
+        EXPECT_TRUE(chain.remove());
+    }
+}
+
+TEST_F(ChainTest, TipHash)
+{
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    Core::Storage::Chain chain(makeTempPath());
+
+    EXPECT_TRUE(chain.create("You can\'t steer a parked car", privateKey, publicKey));
+
+    const Core::Crypto::SHA256::Hash::Ptr genesisHash = chain.getTipHash();
+
+    EXPECT_TRUE(genesisHash);
+
+    EXPECT_TRUE(chain.open());
+
+    const Core::Crypto::SHA256::Hash::Ptr tipHash = chain.getTipHash();
+
+    EXPECT_TRUE(tipHash);
+
+    EXPECT_EQ(memcmp(tipHash->data(), genesisHash->data(), tipHash->length()), 0);
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        const Core::Storage::Block::Ptr block = getBlock("Hash " + std::to_string(i));
+
+        EXPECT_TRUE(block);
+
+        EXPECT_TRUE(chain.addBlock(block));
+
+        const Core::Crypto::SHA256::Hash::Ptr hash = chain.getTipHash();
+
+        EXPECT_TRUE(hash);
+
+        EXPECT_EQ(memcmp(hash->data(), block->getData()->getHash()->data(), hash->length()), 0);
+
+        EXPECT_EQ(chain.getHeader()->getIndex(), i + 1);
+    }
+
+    const Core::Crypto::SHA256::Hash::Ptr lastHash = chain.getTipHash();
+
+    EXPECT_TRUE(chain.close());
+
+    const Core::Crypto::SHA256::Hash::Ptr storedHash = chain.getTipHash();
+
+    EXPECT_TRUE(storedHash);
+
+    EXPECT_EQ(memcmp(storedHash->data(), lastHash->data(), storedHash->length()), 0);
+
+    uint64_t dataSize = 0;
+    uint64_t storageSize = 0;
+
+    EXPECT_TRUE(chain.getSize(dataSize, storageSize));
+
+    EXPECT_GT(dataSize, 0);
+
+    EXPECT_TRUE(chain.remove());
+}
+
+TEST_F(ChainTest, LogEngine)
+{
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Chain chain(path);
+
+    EXPECT_TRUE(chain.create("You can\'t steer a parked car",
+        privateKey,
+        publicKey,
+        Core::Storage::Storage::SYNC,
+        Core::Storage::Chain::LOG));
+
+    EXPECT_TRUE(std::filesystem::exists(path + ".log"));
+
+    EXPECT_TRUE(chain.open());
+
+    std::vector<Core::Storage::Block::Ptr> addedBlocks;
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        const Core::Storage::Block::Ptr block = getBlock();
+
+        EXPECT_TRUE(block);
+
+        EXPECT_TRUE(chain.addBlock(block, i % 2 ? Core::Storage::Storage::SYNC : Core::Storage::Storage::PERIODIC));
+
+        addedBlocks.push_back(block);
+    }
+
+    EXPECT_TRUE(chain.sync());
+    EXPECT_TRUE(chain.close());
+
+    const Core::Storage::Chain::Header::Ptr header = chain.getHeader();
+
+    EXPECT_TRUE(header);
+
+    EXPECT_EQ(header->getEngine(), Core::Storage::Chain::LOG);
+    EXPECT_EQ(header->getIndex(), 5);
+
+    EXPECT_TRUE(chain.open());
+
+    const Core::Storage::Block::Ptr block = chain.getBlock(3);
+
+    EXPECT_TRUE(block);
+
+    EXPECT_EQ(memcmp(block->getData()->getHash()->data(),
+        addedBlocks[2]->getData()->getHash()->data(),
+        block->getData()->getHash()->length()), 0);
+
+    std::vector<Core::Storage::Block::Ptr> blocks;
+    size_t nextIndex = 0;
+
+    EXPECT_TRUE(chain.getBlocks(0, 2, 1 << 20, true, blocks, nextIndex));
+
+    EXPECT_EQ(blocks.size(), 2);
+    EXPECT_EQ(nextIndex, 3);
+
+    uint64_t dataSize = 0;
+    uint64_t storageSize = 0;
+
+    EXPECT_TRUE(chain.getSize(dataSize, storageSize));
+
+    EXPECT_GT(dataSize, 0);
+    EXPECT_GT(storageSize, dataSize);
+
+    EXPECT_TRUE(chain.close());
+
+    EXPECT_TRUE(chain.remove());
+
+    EXPECT_FALSE(std::filesystem::exists(path + ".log"));
+}
+
 TEST_F(ChainTest, Remove)
 {
     const Core::Storage::Chain::Header::Data& data = "You can\'t steer a parked car";
@@ -301,6 +684,54 @@ TEST_F(ChainTest, Remove)
     EXPECT_TRUE(chain.remove());
 }
 
+TEST_F(ChainTest, Open)
+{
+    const Core::Storage::Chain::Header::Data& data = "You can\'t steer a parked car";
+
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    Core::Storage::Chain chain(makeTempPath());
+
+    EXPECT_FALSE(chain.open());
+
+    EXPECT_TRUE(chain.create(data, privateKey, publicKey));
+
+    EXPECT_TRUE(chain.open());
+    EXPECT_FALSE(chain.open());
+
+    EXPECT_TRUE(chain.isOpen());
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        const Core::Storage::Block::Ptr block = getBlock();
+
+        EXPECT_TRUE(block);
+
+        EXPECT_TRUE(chain.addBlock(block));
+    }
+
+    EXPECT_TRUE(chain.getBlock(4));
+
+    EXPECT_FALSE(chain.remove());
+
+    EXPECT_TRUE(chain.close());
+    EXPECT_FALSE(chain.close());
+
+    EXPECT_FALSE(chain.isOpen());
+
+    EXPECT_TRUE(chain.getBlock(4));
+
+    EXPECT_TRUE(chain.remove());
+}
+
 TEST_F(ChainTest, GetHeader)
 {
     const Core::Storage::Chain::Header::Data& data = "You can\'t steer a parked car";
@@ -335,5 +766,151 @@ TEST_F(ChainTest, GetHeader)
     EXPECT_EQ(memcmp(header->getPrivateKey()->data(), privateKey->data(), header->getPrivateKey()->length()), 0);
     EXPECT_EQ(memcmp(header->getPublicKey()->data(), publicKey->data(), header->getPublicKey()->length()), 0);
 
+    EXPECT_TRUE(chain.remove());
+}
+
+TEST_F(ChainTest, Upgrade)
+{
+    const Core::Storage::Chain::Header::Data& data = "You can\'t steer a parked car";
+
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    const std::string& path = makeTempPath();
+
+    std::vector<Core::Storage::Block::Ptr> addedBlocks;
+    uint64_t addedSize = 0;
+
+    {
+        Core::Storage::Storage storage(path);
+
+        EXPECT_TRUE(storage.create());
+
+        for (size_t i = 1; i <= 12; i++)
+        {
+            const Core::Storage::Block::Ptr block = getBlock();
+
+            EXPECT_TRUE(block);
+
+            Core::Storage::Block::Container::Data buffer;
+
+            EXPECT_TRUE(Core::Storage::Block::Container::pack(block->getData(), buffer));
+
+            EXPECT_TRUE(storage.set({{Core::Storage::DB_LEGACY_BLOCK_KEY + std::to_string(i), buffer}}));
+
+            addedSize += buffer.size();
+
+            addedBlocks.push_back(block);
+        }
+
+        const Core::Storage::Chain::Header::Ptr header = std::make_shared<Core::Storage::Chain::Header>(
+            1,
+            12,
+            data,
+            privateKey,
+            publicKey
+        );
+
+        Core::Storage::Chain::Header::Data buffer;
+
+        EXPECT_TRUE(Core::Storage::Chain::Header::pack(header, buffer));
+
+        EXPECT_TRUE(storage.set({{Core::Storage::DB_HEADER_KEY, buffer}}));
+    }
+
+    Core::Storage::Chain chain(path);
+
+    EXPECT_TRUE(chain.open());
+
+    const Core::Storage::Chain::Header::Ptr header = chain.getHeader();
+
+    EXPECT_TRUE(header);
+
+    EXPECT_EQ(header->getVersion(), DB_VERSION);
+    EXPECT_EQ(header->getIndex(), 12);
+    EXPECT_EQ(header->getData(), data);
+
+    uint64_t dataSize = 0;
+    uint64_t storageSize = 0;
+
+    EXPECT_TRUE(chain.getSize(dataSize, storageSize));
+
+    EXPECT_EQ(dataSize, addedSize);
+
+    const Core::Crypto::SHA256::Hash::Ptr hash = addedBlocks[0]->getData()->getHash();
+
+    EXPECT_TRUE(chain.getBlockByHash(std::string(reinterpret_cast<const char*>(hash->data()), hash->length())));
+
+    const Core::Crypto::SHA256::Hash::Ptr tipHash = chain.getTipHash();
+
+    EXPECT_TRUE(tipHash);
+
+    EXPECT_EQ(memcmp(tipHash->data(), addedBlocks[11]->getData()->getHash()->data(), tipHash->length()), 0);
+
+    EXPECT_TRUE(chain.addBlock(getBlock()));
+
+    std::vector<Core::Storage::Block::Ptr> blocks;
+
+    EXPECT_TRUE(chain.getBlocks(blocks));
+
+    EXPECT_EQ(blocks.size(), 13);
+
+    for (size_t i = 0; i < addedBlocks.size(); i++)
+    {
+        EXPECT_EQ(memcmp(blocks[i]->getData()->getHash()->data(),
+            addedBlocks[i]->getData()->getHash()->data(),
+            blocks[i]->getData()->getHash()->length()), 0);
+    }
+
+    EXPECT_TRUE(chain.close());
+    EXPECT_TRUE(chain.remove());
+}
+
+TEST_F(ChainTest, UnsupportedVersion)
+{
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+
+    EXPECT_TRUE(privateKey);
+
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    EXPECT_TRUE(publicKey);
+
+    const std::string& path = makeTempPath();
+
+    {
+        Core::Storage::Storage storage(path);
+
+        EXPECT_TRUE(storage.create());
+
+        const Core::Storage::Chain::Header::Ptr header = std::make_shared<Core::Storage::Chain::Header>(
+            DB_VERSION + 1,
+            0,
+            "",
+            privateKey,
+            publicKey
+        );
+
+        Core::Storage::Chain::Header::Data buffer;
+
+        EXPECT_TRUE(Core::Storage::Chain::Header::pack(header, buffer));
+
+        EXPECT_TRUE(storage.set({{Core::Storage::DB_HEADER_KEY, buffer}}));
+    }
+
+    Core::Storage::Chain chain(path);
+
+    EXPECT_FALSE(chain.open());
+    EXPECT_FALSE(chain.getHeader());
+
     EXPECT_TRUE(chain.remove());
 }
\ No newline at end of file
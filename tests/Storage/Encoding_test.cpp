@@ -0,0 +1,87 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include "Storage/Encoding.h"
+
+TEST(Encoding, UInt64)
+{
+    const std::vector<uint64_t> values = {0, 1, 255, 256, 65535, 4294967296, UINT64_MAX};
+
+    for (const uint64_t value : values)
+    {
+        const std::string& data = Core::Storage::Encoding::encodeUInt64(value);
+
+        EXPECT_EQ(data.size(), sizeof(value));
+
+        uint64_t result = 0;
+
+        EXPECT_TRUE(Core::Storage::Encoding::decodeUInt64(data, result));
+
+        EXPECT_EQ(result, value);
+    }
+
+    EXPECT_EQ(Core::Storage::Encoding::encodeUInt64(1), std::string("\0\0\0\0\0\0\0\1", 8));
+}
+
+TEST(Encoding, UInt64Order)
+{
+    EXPECT_LT(Core::Storage::Encoding::encodeUInt64(9), Core::Storage::Encoding::encodeUInt64(10));
+    EXPECT_LT(Core::Storage::Encoding::encodeUInt64(255), Core::Storage::Encoding::encodeUInt64(256));
+    EXPECT_LT(Core::Storage::Encoding::encodeUInt64(65535), Core::Storage::Encoding::encodeUInt64(4294967296));
+}
+
+TEST(Encoding, UInt64InvalidLength)
+{
+    uint64_t result = 0;
+
+    EXPECT_FALSE(Core::Storage::Encoding::decodeUInt64("", result));
+    EXPECT_FALSE(Core::Storage::Encoding::decodeUInt64("1234567", result));
+    EXPECT_FALSE(Core::Storage::Encoding::decodeUInt64("123456789", result));
+}
+
+TEST(Encoding, WriteUInt64)
+{
+    char data[8];
+
+    Core::Storage::Encoding::writeUInt64(data, 0x0102030405060708);
+
+    EXPECT_EQ(std::string(data, sizeof(data)), Core::Storage::Encoding::encodeUInt64(0x0102030405060708));
+    EXPECT_EQ(Core::Storage::Encoding::readUInt64(data), 0x0102030405060708);
+}
+
+TEST(Encoding, UInt32)
+{
+    char data[4];
+
+    Core::Storage::Encoding::writeUInt32(data, 0x01020304);
+
+    EXPECT_EQ(std::string(data, sizeof(data)), "\1\2\3\4");
+    EXPECT_EQ(Core::Storage::Encoding::readUInt32(data), 0x01020304);
+}
+
+TEST(Encoding, Crc32)
+{
+    EXPECT_EQ(Core::Storage::Encoding::crc32("", 0), 0);
+    EXPECT_EQ(Core::Storage::Encoding::crc32("123456789", 9), 0xCBF43926);
+}
@@ -0,0 +1,259 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "BaseTest.h"
+
+#include "Storage/Log.h"
+
+class LogTest : public BaseTest
+{
+};
+
+TEST_F(LogTest, Create)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Log log(path);
+
+    EXPECT_TRUE(log.create());
+    EXPECT_TRUE(log.isOpen());
+    EXPECT_EQ(log.size(), 0);
+
+    EXPECT_TRUE(log.close());
+
+    EXPECT_FALSE(log.create());
+
+    EXPECT_TRUE(log.remove());
+}
+
+TEST_F(LogTest, Append)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Log log(path);
+
+    EXPECT_TRUE(log.create());
+
+    EXPECT_TRUE(log.append({"Record 1", "Record 2"}, true));
+    EXPECT_TRUE(log.append({"Record 3"}, false));
+
+    EXPECT_EQ(log.size(), 3);
+    EXPECT_EQ(log.getDataSize(), 24);
+
+    Core::Storage::Log::Data data;
+
+    EXPECT_TRUE(log.get(1, data));
+    EXPECT_EQ(data, "Record 1");
+
+    EXPECT_TRUE(log.get(3, data));
+    EXPECT_EQ(data, "Record 3");
+
+    EXPECT_FALSE(log.get(0, data));
+    EXPECT_FALSE(log.get(4, data));
+
+    EXPECT_TRUE(log.sync());
+    EXPECT_TRUE(log.close());
+
+    EXPECT_TRUE(log.remove());
+}
+
+TEST_F(LogTest, Segments)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Log::DataList records;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        records.push_back("Record " + std::to_string(i));
+    }
+
+    {
+        Core::Storage::Log log(path, 64);
+
+        EXPECT_TRUE(log.create());
+
+        for (const Core::Storage::Log::Data& record : records)
+        {
+            EXPECT_TRUE(log.append({record}, false));
+        }
+
+        EXPECT_TRUE(log.sync());
+        EXPECT_TRUE(log.close());
+    }
+
+    size_t seals = 0;
+
+    for (const auto& entry : std::filesystem::directory_iterator(path))
+    {
+        seals += entry.path().extension() == ".seal";
+    }
+
+    EXPECT_GT(seals, 1);
+
+    Core::Storage::Log log(path, 64);
+
+    EXPECT_TRUE(log.open());
+    EXPECT_EQ(log.size(), records.size());
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        Core::Storage::Log::Data data;
+
+        EXPECT_TRUE(log.get(i + 1, data));
+        EXPECT_EQ(data, records[i]);
+    }
+
+    EXPECT_TRUE(log.close());
+
+    EXPECT_TRUE(log.remove());
+}
+
+TEST_F(LogTest, Recover)
+{
+    const std::string& path = makeTempPath();
+
+    {
+        Core::Storage::Log log(path);
+
+        EXPECT_TRUE(log.create());
+        EXPECT_TRUE(log.append({"Record 1", "Record 2"}, true));
+        EXPECT_TRUE(log.close());
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(path))
+    {
+        if (entry.path().extension() == ".data")
+        {
+            std::ofstream file(entry.path(), std::ios::binary | std::ios::app);
+
+            file << "Torn record";
+        }
+    }
+
+    Core::Storage::Log log(path);
+
+    EXPECT_TRUE(log.open());
+    EXPECT_EQ(log.size(), 2);
+
+    EXPECT_TRUE(log.append({"Record 3"}, true));
+
+    Core::Storage::Log::Data data;
+
+    EXPECT_TRUE(log.get(3, data));
+    EXPECT_EQ(data, "Record 3");
+
+    EXPECT_TRUE(log.close());
+
+    EXPECT_TRUE(log.remove());
+}
+
+TEST_F(LogTest, Truncate)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Log log(path, 32);
+
+    EXPECT_TRUE(log.create());
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        EXPECT_TRUE(log.append({"Record " + std::to_string(i)}, false));
+    }
+
+    EXPECT_TRUE(log.truncate(3));
+    EXPECT_EQ(log.size(), 3);
+
+    Core::Storage::Log::Data data;
+
+    EXPECT_FALSE(log.get(4, data));
+
+    EXPECT_TRUE(log.append({"Record"}, true));
+    EXPECT_TRUE(log.get(4, data));
+    EXPECT_EQ(data, "Record");
+
+    EXPECT_TRUE(log.close());
+    EXPECT_TRUE(log.open());
+
+    EXPECT_EQ(log.size(), 4);
+
+    EXPECT_TRUE(log.close());
+
+    EXPECT_TRUE(log.remove());
+}
+
+TEST_F(LogTest, Checkpoint)
+{
+    const std::string& path = makeTempPath();
+    const std::string& checkpointPath = makeTempPath();
+
+    Core::Storage::Log log(path, 64);
+
+    EXPECT_TRUE(log.create());
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        EXPECT_TRUE(log.append({"Record " + std::to_string(i)}, false));
+    }
+
+    EXPECT_TRUE(log.checkpoint(checkpointPath));
+    EXPECT_FALSE(log.checkpoint(checkpointPath));
+
+    EXPECT_TRUE(log.append({"Record 20"}, true));
+
+    {
+        Core::Storage::Log checkpoint(checkpointPath, 64);
+
+        EXPECT_TRUE(checkpoint.open());
+        EXPECT_EQ(checkpoint.size(), 20);
+
+        Core::Storage::Log::Data data;
+
+        EXPECT_TRUE(checkpoint.get(20, data));
+        EXPECT_EQ(data, "Record 19");
+
+        EXPECT_TRUE(checkpoint.truncate(2));
+        EXPECT_TRUE(checkpoint.close());
+    }
+
+    EXPECT_EQ(log.size(), 21);
+
+    for (size_t i = 1; i <= 21; i++)
+    {
+        Core::Storage::Log::Data data;
+
+        EXPECT_TRUE(log.get(i, data));
+        EXPECT_EQ(data, "Record " + std::to_string(i - 1));
+    }
+
+    EXPECT_TRUE(log.close());
+    EXPECT_TRUE(log.open());
+    EXPECT_EQ(log.size(), 21);
+    EXPECT_TRUE(log.close());
+
+    EXPECT_TRUE(log.remove());
+    EXPECT_TRUE(Core::Storage::Log(checkpointPath).remove());
+}
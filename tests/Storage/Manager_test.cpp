@@ -22,9 +22,16 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <thread>
+
 #include "BaseTest.h"
 
 #include "Storage/Manager.h"
+#include "Storage/Protocol.h"
+#include "Storage/Encoding.h"
 
 class ManagerTest : public BaseTest
 {
@@ -69,6 +76,57 @@ TEST_F(ManagerTest, RemoveChain)
     EXPECT_TRUE(removeDirectory(path));
 }
 
+TEST_F(ManagerTest, RemoveChainAsync)
+{
+    for (const Core::Storage::Manager::Layout layout : {Core::Storage::Manager::SEPARATE, Core::Storage::Manager::SHARED})
+    {
+        const std::string& path = createTempDirectory();
+
+        Core::Storage::Storage::Options options;
+
+        options.reclaimInterval = 0;
+
+        Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT, options, layout);
+
+        for (size_t chainId = 1; chainId <= 2; chainId++)
+        {
+            EXPECT_TRUE(manager.createChain(chainId, "You can\'t steer a parked car"));
+            EXPECT_TRUE(manager.addBlock(chainId, "You can\'t steer a parked bike"));
+            EXPECT_TRUE(manager.removeChain(chainId));
+
+            EXPECT_FALSE(manager.hasChain(chainId));
+            EXPECT_FALSE(manager.getBlock(chainId, 1));
+        }
+
+        Core::Storage::Manager::ChainInfo info;
+
+        EXPECT_FALSE(manager.getChainInfo(1, info));
+
+        Core::Storage::Reclaimer::Stats stats;
+
+        EXPECT_TRUE(manager.getReclaimStats(stats));
+        EXPECT_EQ(stats.pendingChains, 2);
+        EXPECT_EQ(stats.reclaimedChains, 0);
+
+        EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car"));
+        EXPECT_TRUE(manager.getChainHeader(1));
+        EXPECT_EQ(manager.getChainHeader(1)->getIndex(), 0);
+
+        EXPECT_TRUE(manager.getReclaimStats(stats));
+        EXPECT_EQ(stats.pendingChains, 1);
+        EXPECT_EQ(stats.reclaimedChains, 1);
+        EXPECT_GT(stats.reclaimedBytes, 0);
+
+        EXPECT_TRUE(manager.cloneChain(1, 2));
+        EXPECT_TRUE(manager.verifyChain(2));
+
+        EXPECT_TRUE(manager.getReclaimStats(stats));
+        EXPECT_EQ(stats.pendingChains, 0);
+
+        EXPECT_TRUE(removeDirectory(path));
+    }
+}
+
 TEST_F(ManagerTest, AddBlock)
 {
     const std::string& path = createTempDirectory();
@@ -85,6 +143,44 @@ TEST_F(ManagerTest, AddBlock)
     EXPECT_TRUE(removeDirectory(path));
 }
 
+TEST_F(ManagerTest, AddBlockConcurrently)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car"));
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&manager]()
+        {
+            for (size_t j = 0; j < 16; j++)
+            {
+                EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    Core::Storage::Manager::BlockList blocks;
+
+    EXPECT_TRUE(manager.getBlocks(1, blocks));
+    EXPECT_EQ(blocks.size(), 64);
+
+    EXPECT_TRUE(manager.verifyChain(1));
+
+    EXPECT_TRUE(manager.removeChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
 TEST_F(ManagerTest, GetBlock)
 {
     const std::string& path = createTempDirectory();
@@ -151,6 +247,518 @@ TEST_F(ManagerTest, VerifyChain)
     EXPECT_TRUE(removeDirectory(path));
 }
 
+TEST_F(ManagerTest, ImportBlocks)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Manager manager(path);
+
+    for (const Core::Storage::Chain::Engine engine : {Core::Storage::Chain::STORAGE, Core::Storage::Chain::LOG})
+    {
+        EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car", Core::Storage::Storage::SYNC, engine));
+
+        EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+
+        size_t index = 0;
+
+        EXPECT_FALSE(manager.importBlocks(2, {"You can\'t steer a parked bike"}, index));
+
+        EXPECT_TRUE(manager.importBlocks(1, std::vector<std::string>(100, "You can\'t steer a parked bike"), index));
+        EXPECT_EQ(index, 101);
+
+        EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+
+        const Core::Storage::Block::Ptr block = manager.getBlock(1, 50);
+
+        EXPECT_TRUE(block);
+        EXPECT_TRUE(manager.getBlockByHash(1, std::string(
+            reinterpret_cast<const char*>(block->getData()->getHash()->data()),
+            block->getData()->getHash()->length())));
+
+        EXPECT_TRUE(manager.verifyChain(1));
+
+        Core::Storage::Manager::ChainInfo info;
+
+        EXPECT_TRUE(manager.getChainInfo(1, info));
+        EXPECT_EQ(info.index, 102);
+
+        EXPECT_TRUE(manager.removeChain(1));
+    }
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, Dedup)
+{
+    const std::string& path = createTempDirectory();
+
+    const std::string status(DEDUP_MIN_LENGTH, 's');
+    const std::string document(DEDUP_MIN_LENGTH * 2, 'd');
+
+    for (const Core::Storage::Chain::Engine engine : {Core::Storage::Chain::STORAGE, Core::Storage::Chain::LOG})
+    {
+        {
+            Core::Storage::Manager manager(path);
+
+            EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car",
+                Core::Storage::Storage::SYNC, engine, true));
+
+            EXPECT_TRUE(manager.addBlock(1, status));
+            EXPECT_TRUE(manager.addBlock(1, document));
+            EXPECT_TRUE(manager.addBlock(1, status));
+            EXPECT_TRUE(manager.addBlock(1, "Heartbeat"));
+
+            size_t index = 0;
+
+            EXPECT_TRUE(manager.importBlocks(1, {status, document, status}, index));
+            EXPECT_EQ(index, 7);
+        }
+
+        Core::Storage::Manager manager(path);
+
+        const Core::Storage::Block::Ptr block = manager.getBlock(1, 6);
+
+        EXPECT_TRUE(block);
+        EXPECT_EQ(block->getData()->getData(), document);
+        EXPECT_TRUE(block->getData()->getPayloadHash());
+
+        EXPECT_EQ(manager.getBlock(1, 4)->getData()->getData(), "Heartbeat");
+        EXPECT_FALSE(manager.getBlock(1, 4)->getData()->getPayloadHash());
+
+        Core::Storage::Manager::BlockList blocks;
+
+        EXPECT_TRUE(manager.getBlocks(1, blocks));
+        EXPECT_EQ(blocks.size(), 7);
+        EXPECT_EQ(blocks[6]->getData()->getData(), status);
+
+        EXPECT_TRUE(manager.verifyChain(1));
+
+        Core::Storage::Manager::ChainInfo info;
+
+        EXPECT_TRUE(manager.getChainInfo(1, info));
+        EXPECT_TRUE(info.dedup);
+        EXPECT_EQ(info.payloadSize, status.size() * 4 + document.size() * 2);
+        EXPECT_EQ(info.storedPayloadSize, status.size() + document.size());
+
+        EXPECT_TRUE(manager.addBlock(1, document));
+        EXPECT_TRUE(manager.getChainInfo(1, info));
+        EXPECT_EQ(info.storedPayloadSize, status.size() + document.size());
+
+        EXPECT_TRUE(manager.removeChain(1));
+    }
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car"));
+    EXPECT_TRUE(manager.addBlock(1, status));
+
+    Core::Storage::Manager::ChainInfo info;
+
+    EXPECT_TRUE(manager.getChainInfo(1, info));
+    EXPECT_FALSE(info.dedup);
+    EXPECT_EQ(info.payloadSize, 0);
+    EXPECT_FALSE(manager.getBlock(1, 1)->getData()->getPayloadHash());
+
+    EXPECT_TRUE(manager.removeChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, Retention)
+{
+    const std::string& path = createTempDirectory();
+
+    const std::string document(DEDUP_MIN_LENGTH * 2, 'd');
+
+    const Core::Crypto::SHA256::Hash::Ptr documentHash = Core::Crypto::SHA256::getHash({document});
+
+    for (const bool dedup : {false, true})
+    {
+        Core::Storage::Manager manager(path);
+
+        EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car",
+            Core::Storage::Storage::SYNC, Core::Storage::Chain::STORAGE, dedup));
+
+        for (size_t i = 0; i < 5; i++)
+        {
+            EXPECT_TRUE(manager.addBlock(1, document));
+        }
+
+        EXPECT_TRUE(manager.addBlock(1, "Heartbeat"));
+
+        Core::Storage::Manager::ChainInfo info;
+
+        EXPECT_TRUE(manager.getChainInfo(1, info));
+
+        const uint64_t dataSize = info.dataSize;
+
+        size_t count = 0;
+
+        EXPECT_TRUE(manager.pruneChain(1, 0, count));
+        EXPECT_EQ(count, 0);
+
+        EXPECT_TRUE(manager.setRetention(1, 2, 0));
+        EXPECT_TRUE(manager.pruneChain(1, 0, count));
+        EXPECT_EQ(count, 4);
+
+        const Core::Storage::Block::Ptr block = manager.getBlock(1, 1);
+
+        EXPECT_TRUE(block);
+        EXPECT_TRUE(block->getData()->isPruned());
+        EXPECT_TRUE(block->getData()->getData().empty());
+        EXPECT_TRUE(block->getData()->getPayloadHash());
+        EXPECT_EQ(memcmp(block->getData()->getPayloadHash()->data(), documentHash->data(), documentHash->length()), 0);
+        EXPECT_TRUE(block->getData()->getTimestamp());
+
+        EXPECT_FALSE(manager.getBlock(1, 5)->getData()->isPruned());
+        EXPECT_EQ(manager.getBlock(1, 5)->getData()->getData(), document);
+
+        EXPECT_TRUE(manager.verifyChain(1));
+
+        EXPECT_TRUE(manager.getChainInfo(1, info));
+        EXPECT_EQ(info.retainBlocks, 2);
+        EXPECT_EQ(info.prunedIndex, 4);
+
+        if (dedup)
+        {
+            EXPECT_EQ(info.payloadSize, document.size());
+            EXPECT_EQ(info.storedPayloadSize, document.size());
+        }
+        else
+        {
+            EXPECT_LT(info.dataSize, dataSize);
+        }
+
+        EXPECT_TRUE(manager.pruneChain(1, 0, count));
+        EXPECT_EQ(count, 0);
+
+        const uint64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        EXPECT_TRUE(manager.setRetention(1, 0, 60));
+        EXPECT_TRUE(manager.pruneChain(1, now, count));
+        EXPECT_EQ(count, 0);
+
+        EXPECT_TRUE(manager.pruneChain(1, now + 60, count));
+        EXPECT_EQ(count, 2);
+
+        EXPECT_TRUE(manager.addBlock(1, document));
+        EXPECT_TRUE(manager.verifyChain(1));
+
+        EXPECT_TRUE(manager.getChainInfo(1, info));
+        EXPECT_EQ(info.retainAge, 60);
+        EXPECT_EQ(info.prunedIndex, 6);
+
+        if (dedup)
+        {
+            EXPECT_EQ(info.storedPayloadSize, document.size());
+        }
+
+        EXPECT_TRUE(manager.removeChain(1));
+    }
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.createChain(2, "You can\'t steer a parked car",
+        Core::Storage::Storage::SYNC, Core::Storage::Chain::LOG));
+
+    EXPECT_FALSE(manager.setRetention(2, 1, 0));
+    EXPECT_TRUE(manager.setRetention(2, 0, 0));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, VerifyPrunedChain)
+{
+    const std::string& path = createTempDirectory();
+
+    {
+        Core::Storage::Manager manager(path);
+
+        EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car"));
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+        }
+
+        size_t count = 0;
+
+        EXPECT_TRUE(manager.setRetention(1, 1, 0));
+        EXPECT_TRUE(manager.pruneChain(1, 0, count));
+        EXPECT_EQ(count, 2);
+
+        EXPECT_TRUE(manager.verifyChain(1));
+    }
+
+    {
+        Core::Storage::Storage storage(path + "/1.blockchain");
+
+        EXPECT_TRUE(storage.open());
+
+        const std::string& name = Core::Storage::DB_BLOCK_KEY + Core::Storage::Encoding::encodeUInt64(1);
+
+        const Core::Storage::Storage::KeyValue::Ptr pair = storage.get(name);
+
+        EXPECT_TRUE(pair);
+
+        const Core::Storage::Block::Container::Ptr container = Core::Storage::Block::Container::unpack(pair->getValue());
+
+        EXPECT_TRUE(container);
+        EXPECT_TRUE(container->isPruned());
+
+        const Core::Storage::Block::Container::Ptr tampered = std::make_shared<Core::Storage::Block::Container>(
+            container->getHash(),
+            Core::Crypto::SHA256::getHash({"You can\'t steer a parked car"}),
+            container->getNonce(),
+            Core::Storage::Block::Container::Data(),
+            container->getSignature(),
+            container->getChunks(),
+            container->getPayloadHash(),
+            container->getTimestamp(),
+            true);
+
+        Core::Storage::Block::Container::Data data;
+
+        EXPECT_TRUE(Core::Storage::Block::Container::pack(tampered, data));
+        EXPECT_TRUE(storage.set({{name, data}}));
+
+        EXPECT_TRUE(storage.close());
+    }
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_FALSE(manager.verifyChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, Archive)
+{
+    const std::string& path = createTempDirectory();
+
+    const std::string document(DEDUP_MIN_LENGTH * 2, 'd');
+
+    std::vector<std::string> payloads;
+
+    for (size_t i = 0; i < ARCHIVE_RANGE_SIZE * 2 + 10; i++)
+    {
+        payloads.push_back(i % 2 ? document : "Block " + std::to_string(i));
+    }
+
+    for (const bool dedup : {false, true})
+    {
+        {
+            Core::Storage::Manager manager(path);
+
+            EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car",
+                Core::Storage::Storage::SYNC, Core::Storage::Chain::STORAGE, dedup));
+
+            size_t index = 0;
+
+            EXPECT_TRUE(manager.importBlocks(1, payloads, index));
+
+            size_t count = 0;
+
+            EXPECT_TRUE(manager.archiveChain(1, ARCHIVE_RANGE_SIZE * 2, count));
+            EXPECT_EQ(count, 0);
+
+            EXPECT_TRUE(manager.archiveChain(1, 10, count));
+            EXPECT_EQ(count, ARCHIVE_RANGE_SIZE * 2);
+
+            Core::Storage::Manager::ChainInfo info;
+
+            EXPECT_TRUE(manager.getChainInfo(1, info));
+            EXPECT_EQ(info.archivedIndex, ARCHIVE_RANGE_SIZE * 2);
+            EXPECT_GT(info.archiveSize, 0);
+
+            if (dedup)
+            {
+                EXPECT_EQ(info.payloadSize, document.size() * 5);
+                EXPECT_EQ(info.storedPayloadSize, document.size());
+            }
+
+            EXPECT_TRUE(manager.addBlock(1, document));
+        }
+
+        Core::Storage::Manager manager(path);
+
+        for (const size_t index : {1, 2, ARCHIVE_RANGE_SIZE, ARCHIVE_RANGE_SIZE * 2, ARCHIVE_RANGE_SIZE * 2 + 1})
+        {
+            const Core::Storage::Block::Ptr block = manager.getBlock(1, index);
+
+            EXPECT_TRUE(block);
+            EXPECT_EQ(block->getData()->getData(), payloads[index - 1]);
+        }
+
+        const Core::Storage::Block::Ptr block = manager.getBlock(1, 3);
+
+        EXPECT_TRUE(manager.getBlockByHash(1, std::string(
+            reinterpret_cast<const char*>(block->getData()->getHash()->data()),
+            block->getData()->getHash()->length())));
+
+        Core::Storage::Manager::BlockList blocks;
+
+        EXPECT_TRUE(manager.getBlocks(1, blocks));
+        EXPECT_EQ(blocks.size(), payloads.size() + 1);
+
+        for (size_t i = 0; i < payloads.size(); i++)
+        {
+            EXPECT_EQ(blocks[i]->getData()->getData(), payloads[i]);
+        }
+
+        size_t nextIndex = 0;
+
+        blocks.clear();
+
+        EXPECT_TRUE(manager.getBlocks(1, ARCHIVE_RANGE_SIZE * 2 + 2, 4, std::numeric_limits<size_t>::max(), true, blocks, nextIndex));
+        EXPECT_EQ(blocks.size(), 4);
+        EXPECT_EQ(nextIndex, ARCHIVE_RANGE_SIZE * 2 - 2);
+        EXPECT_EQ(blocks[3]->getData()->getData(), payloads[ARCHIVE_RANGE_SIZE * 2 - 2]);
+
+        blocks.clear();
+
+        EXPECT_TRUE(manager.getBlocks(1, 0, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max(), true, blocks, nextIndex));
+        EXPECT_EQ(blocks.size(), payloads.size() + 1);
+        EXPECT_EQ(blocks.back()->getData()->getData(), payloads.front());
+
+        EXPECT_TRUE(manager.getBlocksByIndex({{1, 1}, {1, ARCHIVE_RANGE_SIZE * 2 + 5}, {1, payloads.size() + 2}}, blocks));
+        EXPECT_EQ(blocks.size(), 3);
+        EXPECT_EQ(blocks[0]->getData()->getData(), payloads[0]);
+        EXPECT_EQ(blocks[1]->getData()->getData(), payloads[ARCHIVE_RANGE_SIZE * 2 + 4]);
+        EXPECT_FALSE(blocks[2]);
+
+        EXPECT_TRUE(manager.verifyChain(1));
+
+        EXPECT_TRUE(manager.setRetention(1, 1, 0));
+
+        size_t count = 0;
+
+        EXPECT_TRUE(manager.pruneChain(1, 0, count));
+        EXPECT_EQ(count, 10);
+        EXPECT_EQ(manager.getBlock(1, 1)->getData()->getData(), payloads[0]);
+
+        EXPECT_TRUE(manager.cloneChain(1, 2));
+        EXPECT_TRUE(manager.verifyChain(2));
+        EXPECT_EQ(manager.getBlock(2, 1)->getData()->getData(), payloads[0]);
+
+        EXPECT_TRUE(manager.removeChain(1));
+        EXPECT_TRUE(manager.removeChain(2));
+    }
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car",
+        Core::Storage::Storage::SYNC, Core::Storage::Chain::LOG));
+
+    size_t count = 0;
+
+    EXPECT_TRUE(manager.archiveChain(1, 0, count));
+    EXPECT_EQ(count, 0);
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, ArchiveMissingFile)
+{
+    const std::string& path = createTempDirectory();
+
+    std::vector<std::string> payloads;
+
+    for (size_t i = 0; i < ARCHIVE_RANGE_SIZE + 10; i++)
+    {
+        payloads.push_back("Block " + std::to_string(i));
+    }
+
+    {
+        Core::Storage::Manager manager(path);
+
+        EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car"));
+
+        size_t index = 0;
+
+        EXPECT_TRUE(manager.importBlocks(1, payloads, index));
+
+        size_t count = 0;
+
+        EXPECT_TRUE(manager.archiveChain(1, 10, count));
+        EXPECT_EQ(count, ARCHIVE_RANGE_SIZE);
+    }
+
+    const std::string& archivePath = path + "/1.blockchain.archive";
+
+    EXPECT_FALSE(std::filesystem::is_empty(archivePath));
+
+    for (const auto& entry : std::filesystem::directory_iterator(archivePath))
+    {
+        EXPECT_TRUE(std::filesystem::remove(entry.path()));
+    }
+
+    // Archived blocks are gone from the chain, a lost archive file must not go unnoticed
+    Core::Storage::Manager manager(path);
+
+    EXPECT_FALSE(manager.getBlock(1, 1));
+    EXPECT_FALSE(manager.verifyChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, Chunks)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car"));
+
+    const std::string data(MAX_CHUNK_LENGTH, 'x');
+
+    const Core::Crypto::SHA256::Hash::Ptr chunk1 = manager.addChunk(1, data);
+    const Core::Crypto::SHA256::Hash::Ptr chunk2 = manager.addChunk(1, "You can\'t steer a parked bike");
+
+    EXPECT_TRUE(chunk1);
+    EXPECT_TRUE(chunk2);
+
+    EXPECT_FALSE(manager.addChunk(2, data));
+
+    EXPECT_FALSE(manager.addBlock(1, "Document", Core::Storage::Storage::DEFAULT,
+        {chunk1, Core::Crypto::SHA256::getHash({"Missing"})}));
+
+    EXPECT_TRUE(manager.addBlock(1, "Document", Core::Storage::Storage::DEFAULT, {chunk1, chunk2, chunk1}));
+    EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+
+    const Core::Storage::Block::Ptr block = manager.getBlock(1, 1);
+
+    EXPECT_TRUE(block);
+    EXPECT_EQ(block->getData()->getChunks().size(), 3);
+
+    std::string chunk;
+
+    EXPECT_TRUE(manager.getChunk(1, block->getData()->getChunks()[0], chunk));
+    EXPECT_EQ(chunk, data);
+
+    EXPECT_FALSE(manager.getChunk(1, Core::Crypto::SHA256::getHash({"Missing"}), chunk));
+
+    EXPECT_TRUE(manager.verifyChain(1));
+
+    EXPECT_TRUE(manager.addBlock(1, "Revision", Core::Storage::Storage::DEFAULT, {chunk2}));
+
+    size_t count = 0;
+
+    EXPECT_TRUE(manager.setRetention(1, 1, 0));
+    EXPECT_TRUE(manager.pruneChain(1, 0, count));
+    EXPECT_EQ(count, 2);
+
+    EXPECT_FALSE(manager.getChunk(1, chunk1, chunk));
+    EXPECT_TRUE(manager.getChunk(1, chunk2, chunk));
+
+    EXPECT_TRUE(manager.verifyChain(1));
+
+    EXPECT_TRUE(manager.removeChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
 TEST_F(ManagerTest, GetChainHeader)
 {
     const std::string& path = createTempDirectory();
@@ -208,4 +816,289 @@ TEST_F(ManagerTest, GetChainInfo)
     EXPECT_TRUE(manager.removeChain(1));
 
     EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, Durability)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car", Core::Storage::Storage::PERIODIC));
+
+    EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+    EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike", Core::Storage::Storage::ASYNC));
+    EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike", Core::Storage::Storage::SYNC));
+
+    Core::Storage::Manager::ChainInfo info;
+
+    EXPECT_TRUE(manager.getChainInfo(1, info));
+
+    EXPECT_EQ(info.index, 3);
+    EXPECT_EQ(info.durability, Core::Storage::Storage::PERIODIC);
+    EXPECT_GT(info.dataSize, 0);
+
+    EXPECT_TRUE(manager.verifyChain(1));
+
+    EXPECT_TRUE(manager.removeChain(1));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, UpgradeChains)
+{
+    const std::string& path = createTempDirectory();
+
+    {
+        Core::Storage::Manager manager(path);
+
+        for (size_t i = 1; i <= 4; i++)
+        {
+            EXPECT_TRUE(manager.createChain(i, "You can\'t steer a parked car"));
+            EXPECT_TRUE(manager.addBlock(i, "You can\'t steer a parked bike"));
+        }
+    }
+
+    Core::Storage::Manager manager(path);
+
+    EXPECT_TRUE(manager.upgradeChains());
+
+    for (size_t i = 1; i <= 4; i++)
+    {
+        EXPECT_TRUE(manager.verifyChain(i));
+        EXPECT_TRUE(manager.removeChain(i));
+    }
+
+    EXPECT_FALSE(Core::Storage::Manager(path + "/none").upgradeChains());
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, SharedLayout)
+{
+    const std::string& path = createTempDirectory();
+
+    {
+        Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT,
+            Core::Storage::Storage::Options(), Core::Storage::Manager::SHARED);
+
+        for (size_t i = 1; i <= 4; i++)
+        {
+            EXPECT_TRUE(manager.createChain(i, "You can\'t steer a parked car"));
+            EXPECT_FALSE(manager.createChain(i, "You can\'t steer a parked car"));
+
+            for (size_t j = 0; j < i; j++)
+            {
+                EXPECT_TRUE(manager.addBlock(i, "You can\'t steer a parked bike"));
+            }
+        }
+
+        EXPECT_FALSE(manager.getChainHeader(5));
+    }
+
+    Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT,
+        Core::Storage::Storage::Options(), Core::Storage::Manager::SHARED);
+
+    for (size_t i = 1; i <= 4; i++)
+    {
+        Core::Storage::Manager::BlockList blocks;
+
+        EXPECT_TRUE(manager.getBlocks(i, blocks));
+        EXPECT_EQ(blocks.size(), i);
+
+        EXPECT_TRUE(manager.verifyChain(i));
+    }
+
+    EXPECT_TRUE(manager.removeChain(2));
+
+    EXPECT_FALSE(manager.getChainHeader(2));
+    EXPECT_TRUE(manager.verifyChain(3));
+
+    EXPECT_TRUE(manager.createChain(2, "You can\'t steer a parked car"));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, ListChains)
+{
+    for (const Core::Storage::Manager::Layout layout : {Core::Storage::Manager::SEPARATE, Core::Storage::Manager::SHARED})
+    {
+        const std::string& path = createTempDirectory();
+
+        {
+            Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT,
+                Core::Storage::Storage::Options(), layout);
+
+            for (size_t i = 1; i <= 4; i++)
+            {
+                EXPECT_TRUE(manager.createChain(i, "You can\'t steer a parked car"));
+
+                for (size_t j = 0; j < i; j++)
+                {
+                    EXPECT_TRUE(manager.addBlock(i, "You can\'t steer a parked bike"));
+                }
+            }
+
+            EXPECT_TRUE(manager.hasChain(3));
+            EXPECT_FALSE(manager.hasChain(5));
+            EXPECT_FALSE(manager.getChainHeader(5));
+
+            EXPECT_TRUE(manager.removeChain(3));
+            EXPECT_FALSE(manager.hasChain(3));
+
+            Core::Storage::Catalog::EntryList entries;
+            size_t nextId = 0;
+
+            EXPECT_TRUE(manager.listChains(0, 2, entries, nextId));
+            EXPECT_EQ(entries.size(), 2);
+            EXPECT_EQ(entries[1].chainId, 2);
+            EXPECT_EQ(entries[1].index, 2);
+            EXPECT_EQ(entries[1].layout, layout);
+            EXPECT_NE(entries[1].createdAt, 0);
+            EXPECT_NE(entries[1].dataSize, 0);
+            EXPECT_EQ(nextId, 4);
+
+            Core::Storage::Reclaimer::Stats stats = {1, 0, 0};
+
+            for (size_t i = 0; i < 100 && stats.pendingChains; i++)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                EXPECT_TRUE(manager.getReclaimStats(stats));
+            }
+
+            EXPECT_EQ(stats.pendingChains, 0);
+        }
+
+        {
+            Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT,
+                Core::Storage::Storage::Options(), layout);
+
+            Core::Storage::Catalog::EntryList entries;
+            size_t nextId = 0;
+
+            EXPECT_TRUE(manager.listChains(0, 10, entries, nextId));
+            EXPECT_EQ(entries.size(), 3);
+            EXPECT_EQ(entries[1].chainId, 2);
+            EXPECT_EQ(entries[1].index, 2);
+            EXPECT_EQ(entries[2].chainId, 4);
+            EXPECT_EQ(entries[2].index, 4);
+        }
+
+        EXPECT_TRUE(removeDirectory(path + "/catalog.db"));
+
+        Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT,
+            Core::Storage::Storage::Options(), layout);
+
+        Core::Storage::Catalog::EntryList entries;
+        size_t nextId = 0;
+
+        EXPECT_TRUE(manager.listChains(0, 10, entries, nextId));
+        EXPECT_EQ(entries.size(), 3);
+        EXPECT_EQ(entries[2].chainId, 4);
+        EXPECT_EQ(entries[2].index, 4);
+        EXPECT_EQ(nextId, 0);
+
+        EXPECT_TRUE(manager.verifyChain(4));
+
+        EXPECT_TRUE(removeDirectory(path));
+    }
+}
+
+TEST_F(ManagerTest, CacheEviction)
+{
+    const std::string& path = createTempDirectory();
+
+    Core::Storage::Manager manager(path, 2, 0);
+
+    for (size_t chainId = 1; chainId <= 4; chainId++)
+    {
+        EXPECT_TRUE(manager.createChain(chainId, "You can\'t steer a parked car"));
+    }
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t chainId = 1; chainId <= 4; chainId++)
+        {
+            EXPECT_TRUE(manager.addBlock(chainId, "You can\'t steer a parked bike"));
+        }
+    }
+
+    for (size_t chainId = 1; chainId <= 4; chainId++)
+    {
+        EXPECT_TRUE(manager.verifyChain(chainId));
+        EXPECT_TRUE(manager.removeChain(chainId));
+    }
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ManagerTest, CloneChain)
+{
+    for (const Core::Storage::Manager::Layout layout : {Core::Storage::Manager::SEPARATE, Core::Storage::Manager::SHARED})
+    {
+        for (const Core::Storage::Chain::Engine engine : {Core::Storage::Chain::STORAGE, Core::Storage::Chain::LOG})
+        {
+            const std::string& path = createTempDirectory();
+
+            Core::Storage::Manager manager(path, CHAIN_CACHE_SIZE, CHAIN_CACHE_TIMEOUT,
+                Core::Storage::Storage::Options(), layout);
+
+            EXPECT_TRUE(manager.createChain(1, "You can\'t steer a parked car", Core::Storage::Storage::SYNC, engine));
+
+            for (size_t i = 0; i < 8; i++)
+            {
+                EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+            }
+
+            EXPECT_FALSE(manager.cloneChain(3, 2));
+
+            EXPECT_TRUE(manager.cloneChain(1, 2));
+            EXPECT_FALSE(manager.cloneChain(1, 2));
+
+            EXPECT_FALSE(manager.backupChain(1, path + "/backup"));
+            EXPECT_FALSE(manager.backupChain(1, "../backup"));
+            EXPECT_FALSE(manager.backupChain(1, "chains/../../backup"));
+
+            EXPECT_TRUE(manager.backupChain(1, "chains/backup"));
+            EXPECT_FALSE(manager.backupChain(1, "chains/backup"));
+
+            EXPECT_TRUE(manager.addBlock(1, "You can\'t steer a parked bike"));
+
+            size_t version = 0;
+            size_t index = 0;
+
+            EXPECT_TRUE(manager.getChainInfo(2, version, index));
+            EXPECT_EQ(index, 8);
+
+            EXPECT_TRUE(manager.verifyChain(2));
+            EXPECT_TRUE(manager.addBlock(2, "You can\'t steer a parked bike"));
+            EXPECT_TRUE(manager.verifyChain(2));
+
+            EXPECT_TRUE(manager.getChainInfo(1, version, index));
+            EXPECT_EQ(index, 9);
+
+            {
+                Core::Storage::Chain backup(path + "/backups/chains/backup");
+
+                EXPECT_TRUE(backup.open());
+
+                const Core::Storage::Chain::Header::Ptr header = backup.getHeader();
+
+                EXPECT_TRUE(header);
+                EXPECT_EQ(header->getIndex(), 8);
+                EXPECT_EQ(header->getEngine(), engine);
+
+                EXPECT_TRUE(backup.getBlock(8));
+
+                EXPECT_TRUE(backup.close());
+                EXPECT_TRUE(backup.remove());
+            }
+
+            EXPECT_TRUE(manager.removeChain(1));
+            EXPECT_TRUE(manager.removeChain(2));
+
+            EXPECT_TRUE(removeDirectory(path));
+        }
+    }
 }
\ No newline at end of file
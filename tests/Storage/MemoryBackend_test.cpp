@@ -0,0 +1,194 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <atomic>
+
+#include "BaseTest.h"
+
+#include "Storage/MemoryBackend.h"
+
+class MemoryBackendTest : public BaseTest
+{
+};
+
+TEST_F(MemoryBackendTest, Create)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::MemoryBackend backend(path);
+
+    EXPECT_FALSE(backend.exists());
+    EXPECT_FALSE(backend.open());
+
+    EXPECT_TRUE(backend.create());
+    EXPECT_TRUE(backend.exists());
+
+    EXPECT_FALSE(Core::Storage::MemoryBackend(path).create());
+    EXPECT_TRUE(Core::Storage::MemoryBackend(path).open());
+
+    EXPECT_TRUE(backend.close());
+    EXPECT_TRUE(backend.remove());
+
+    EXPECT_FALSE(backend.exists());
+}
+
+TEST_F(MemoryBackendTest, Write)
+{
+    Core::Storage::MemoryBackend backend(makeTempPath());
+
+    EXPECT_TRUE(backend.create());
+
+    EXPECT_TRUE(backend.write({{"Key 1", "Value 1"}, {"Key 2", "Value 2"}}, {}, true));
+    EXPECT_TRUE(backend.write({{"Key 1", "Value 3"}}, {"Key 2"}, true));
+
+    Core::Storage::Storage::Slice value;
+
+    EXPECT_TRUE(backend.get("Key 1", value));
+    EXPECT_EQ(value.getData(), "Value 3");
+    EXPECT_TRUE(value.isPinned());
+
+    EXPECT_FALSE(backend.get("Key 2", value));
+    EXPECT_FALSE(backend.get("Key 3", value));
+
+    EXPECT_TRUE(backend.write({{"Key 2", "Value 4"}}, {}, true));
+
+    EXPECT_TRUE(backend.get("Key 2", value));
+    EXPECT_EQ(value.getData(), "Value 4");
+
+    uint64_t size = 0;
+
+    EXPECT_TRUE(backend.getApproximateSize("Key", "Kez", size));
+    EXPECT_EQ(size, 24);
+
+    EXPECT_TRUE(backend.remove());
+}
+
+TEST_F(MemoryBackendTest, Scan)
+{
+    Core::Storage::MemoryBackend backend(makeTempPath());
+
+    EXPECT_TRUE(backend.create());
+
+    Core::Storage::Storage::KeyValueList pairs;
+
+    for (size_t i = 0; i < 1000; i++)
+    {
+        const std::string& key = std::string(4 - std::to_string(i).size(), '0') + std::to_string(i);
+
+        pairs.emplace_back(key, std::to_string(i));
+    }
+
+    EXPECT_TRUE(backend.write(pairs, {}, true));
+    EXPECT_TRUE(backend.write({}, {"0500"}, true));
+
+    const Core::Storage::Storage::Backend::Cursor::Ptr cursor = backend.scan(Core::Storage::Storage::ReadOptions());
+
+    EXPECT_TRUE(backend.write({{"0999", "Updated"}}, {"0000"}, true));
+
+    size_t count = 0;
+
+    for (cursor->seek(""); cursor->isValid(); cursor->next())
+    {
+        count++;
+    }
+
+    EXPECT_EQ(count, 999);
+
+    cursor->seek("0500");
+
+    EXPECT_TRUE(cursor->isValid());
+    EXPECT_EQ(cursor->getKey(), "0501");
+
+    cursor->prev();
+
+    EXPECT_TRUE(cursor->isValid());
+    EXPECT_EQ(cursor->getKey(), "0499");
+
+    cursor->seek("0999");
+
+    EXPECT_TRUE(cursor->isValid());
+    EXPECT_EQ(cursor->getValue(), "999");
+
+    cursor->seek("1000");
+
+    EXPECT_FALSE(cursor->isValid());
+
+    EXPECT_TRUE(backend.remove());
+}
+
+TEST_F(MemoryBackendTest, ConcurrentReads)
+{
+    Core::Storage::MemoryBackend backend(makeTempPath());
+
+    EXPECT_TRUE(backend.create());
+    EXPECT_TRUE(backend.write({{"A", "0"}, {"B", "0"}}, {}, true));
+
+    std::atomic<bool> isStopped(false);
+    std::atomic<size_t> errors(0);
+
+    std::vector<std::thread> readers;
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        readers.emplace_back([&backend, &isStopped, &errors]() {
+            while (!isStopped)
+            {
+                const Core::Storage::Storage::Backend::Cursor::Ptr cursor =
+                    backend.scan(Core::Storage::Storage::ReadOptions());
+
+                cursor->seek("A");
+
+                const std::string a(cursor->getValue());
+
+                cursor->next();
+
+                if (!cursor->isValid() || a != cursor->getValue())
+                {
+                    errors++;
+                }
+            }
+        });
+    }
+
+    for (size_t i = 1; i <= 10000; i++)
+    {
+        EXPECT_TRUE(backend.write({{"A", std::to_string(i)}, {"B", std::to_string(i)}}, {}, false));
+    }
+
+    isStopped = true;
+
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(errors, 0);
+
+    Core::Storage::Storage::Slice value;
+
+    EXPECT_TRUE(backend.get("B", value));
+    EXPECT_EQ(value.getData(), "10000");
+
+    EXPECT_TRUE(backend.remove());
+}
@@ -0,0 +1,116 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "BaseTest.h"
+
+#include "Storage/Pruner.h"
+#include "Storage/Chain.h"
+#include "Crypto/ECDSA.h"
+
+class PrunerTest : public BaseTest
+{
+};
+
+TEST_F(PrunerTest, Prune)
+{
+    const std::string& path = createTempDirectory();
+
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    Core::Storage::Cache cache(4, 0);
+
+    const Core::Storage::Chain::Ptr chain = cache.get(1, [&]() {
+        const Core::Storage::Chain::Ptr chain = std::make_shared<Core::Storage::Chain>(path + "/1");
+
+        EXPECT_TRUE(chain->create("You can\'t steer a parked car", privateKey, publicKey));
+        EXPECT_TRUE(chain->open());
+
+        return chain;
+    });
+
+    EXPECT_TRUE(chain);
+
+    Core::Crypto::SHA256::Hash::Ptr prevHash = chain->getTipHash();
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        const Core::Crypto::SHA256::Hash::Ptr hash = Core::Crypto::SHA256::getHash({std::to_string(i)});
+
+        const Core::Storage::Block::Container::Ptr container = std::make_shared<Core::Storage::Block::Container>(
+            hash,
+            prevHash,
+            Core::Storage::Block::generateNonce(),
+            "You can\'t steer a parked car",
+            secp256k1.getSignature(hash, privateKey));
+
+        EXPECT_TRUE(chain->addBlock(std::make_shared<Core::Storage::Block>(container)));
+
+        prevHash = hash;
+    }
+
+    EXPECT_TRUE(chain->setRetention(1, 0));
+
+    Core::Storage::Pruner pruner(cache, 10, 0);
+
+    pruner.start();
+    pruner.start();
+
+    size_t prunedIndex = 0;
+
+    for (size_t i = 0; i < 100 && prunedIndex < 3; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        EXPECT_TRUE(chain->getPrunedIndex(prunedIndex));
+    }
+
+    pruner.stop();
+    pruner.stop();
+
+    EXPECT_EQ(prunedIndex, 3);
+
+    EXPECT_TRUE(chain->getBlock(3)->getData()->isPruned());
+    EXPECT_FALSE(chain->getBlock(4)->getData()->isPruned());
+    EXPECT_EQ(chain->getBlock(4)->getData()->getData(), "You can\'t steer a parked car");
+
+    cache.clear();
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(PrunerTest, Disabled)
+{
+    Core::Storage::Cache cache(4, 0);
+
+    Core::Storage::Pruner pruner(cache, 0, 0);
+
+    pruner.start();
+    pruner.stop();
+}
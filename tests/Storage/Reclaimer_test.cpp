@@ -0,0 +1,191 @@
+/*
+   Copyright (c) 2021 Stanislav Yakush (st.yakush@yandex.ru)
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <limits>
+
+#include "BaseTest.h"
+
+#include "Storage/Reclaimer.h"
+#include "Storage/Cache.h"
+#include "Crypto/ECDSA.h"
+
+class ReclaimerTest : public BaseTest
+{
+};
+
+TEST_F(ReclaimerTest, Reclaim)
+{
+    const std::string& path = createTempDirectory();
+
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    Core::Storage::Catalog catalog(path + "/catalog");
+
+    EXPECT_TRUE(catalog.create());
+
+    const auto makeChain = [&](const size_t chainId) {
+        return std::make_shared<Core::Storage::Chain>(path + "/" + std::to_string(chainId));
+    };
+
+    for (size_t chainId = 1; chainId <= 2; chainId++)
+    {
+        EXPECT_TRUE(makeChain(chainId)->create("You can\'t steer a parked car", privateKey, publicKey,
+            Core::Storage::Storage::SYNC, Core::Storage::Chain::LOG));
+
+        EXPECT_TRUE(catalog.addChain({chainId, 0, 0, 0, 0}));
+        EXPECT_TRUE(catalog.removeChain(chainId));
+    }
+
+    EXPECT_TRUE(catalog.hasTombstone(1));
+
+    Core::Storage::Reclaimer reclaimer(catalog, makeChain, 0, 0);
+
+    Core::Storage::Reclaimer::Stats stats;
+
+    EXPECT_TRUE(reclaimer.getStats(stats));
+    EXPECT_EQ(stats.pendingChains, 2);
+
+    size_t steps = 0;
+
+    while (stats.pendingChains && steps++ < 1000)
+    {
+        EXPECT_TRUE(reclaimer.reclaim(1));
+        EXPECT_TRUE(reclaimer.getStats(stats));
+    }
+
+    EXPECT_GT(steps, 1);
+    EXPECT_EQ(stats.pendingChains, 0);
+    EXPECT_EQ(stats.reclaimedChains, 2);
+    EXPECT_GT(stats.reclaimedBytes, 0);
+
+    EXPECT_FALSE(catalog.hasTombstone(1));
+    EXPECT_FALSE(std::filesystem::exists(path + "/1"));
+    EXPECT_FALSE(std::filesystem::exists(path + "/2.log"));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ReclaimerTest, Background)
+{
+    const std::string& path = createTempDirectory();
+
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    Core::Storage::Catalog catalog(path + "/catalog");
+
+    EXPECT_TRUE(catalog.create());
+
+    const auto makeChain = [&](const size_t chainId) {
+        return std::make_shared<Core::Storage::Chain>(path + "/" + std::to_string(chainId));
+    };
+
+    EXPECT_TRUE(makeChain(1)->create("You can\'t steer a parked car", privateKey, publicKey));
+
+    EXPECT_TRUE(catalog.addChain({1, 0, 0, 0, 0}));
+    EXPECT_TRUE(catalog.removeChain(1));
+
+    Core::Storage::Reclaimer reclaimer(catalog, makeChain, 10, 0);
+
+    reclaimer.start();
+    reclaimer.start();
+
+    Core::Storage::Reclaimer::Stats stats = {1, 0, 0};
+
+    for (size_t i = 0; i < 100 && stats.pendingChains; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        EXPECT_TRUE(reclaimer.getStats(stats));
+    }
+
+    reclaimer.stop();
+    reclaimer.stop();
+
+    EXPECT_EQ(stats.pendingChains, 0);
+    EXPECT_EQ(stats.reclaimedChains, 1);
+    EXPECT_FALSE(std::filesystem::exists(path + "/1"));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
+
+TEST_F(ReclaimerTest, InUse)
+{
+    const std::string& path = createTempDirectory();
+
+    const Core::Crypto::Secp256k1 secp256k1;
+
+    const Core::Crypto::Secp256k1::PrivateKey::Ptr privateKey = secp256k1.generatePrivateKey();
+    const Core::Crypto::Secp256k1::PublicKey::Ptr publicKey = secp256k1.createPublicKey(privateKey);
+
+    Core::Storage::Catalog catalog(path + "/catalog");
+
+    EXPECT_TRUE(catalog.create());
+
+    const auto makeChain = [&](const size_t chainId) {
+        return std::make_shared<Core::Storage::Chain>(path + "/" + std::to_string(chainId));
+    };
+
+    EXPECT_TRUE(makeChain(1)->create("You can\'t steer a parked car", privateKey, publicKey));
+
+    Core::Storage::Cache cache(4, 0);
+
+    Core::Storage::Chain::Ptr chain = cache.get(1, [&]() {
+        const Core::Storage::Chain::Ptr chain = makeChain(1);
+
+        return chain->open() ? chain : nullptr;
+    });
+
+    EXPECT_TRUE(chain);
+
+    EXPECT_TRUE(catalog.addChain({1, 0, 0, 0, 0}));
+    EXPECT_TRUE(catalog.removeChain(1));
+
+    cache.remove(1);
+
+    Core::Storage::Reclaimer reclaimer(catalog, makeChain, 0, 0,
+        [&cache](const size_t chainId) { return cache.isInUse(chainId); });
+
+    EXPECT_TRUE(reclaimer.reclaim(std::numeric_limits<uint64_t>::max()));
+    EXPECT_FALSE(reclaimer.reclaimChain(1));
+
+    EXPECT_TRUE(catalog.hasTombstone(1));
+    EXPECT_TRUE(std::filesystem::exists(path + "/1"));
+    EXPECT_TRUE(chain->getHeader());
+
+    chain = nullptr;
+
+    EXPECT_TRUE(reclaimer.reclaimChain(1));
+
+    EXPECT_FALSE(catalog.hasTombstone(1));
+    EXPECT_FALSE(std::filesystem::exists(path + "/1"));
+
+    EXPECT_TRUE(removeDirectory(path));
+}
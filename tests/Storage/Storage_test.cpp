@@ -22,8 +22,12 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #include "BaseTest.h"
 
+#include "Defs.h"
+
 #include "Storage/Storage.h"
 
 class StorageTest : public BaseTest
@@ -194,4 +198,498 @@ TEST_F(StorageTest, Update)
 
     EXPECT_TRUE(storage.close());
     EXPECT_TRUE(storage.remove());
+}
+
+TEST_F(StorageTest, Durability)
+{
+    const std::string& path = makeTempPath();
+
+    {
+        Core::Storage::Storage storage(path);
+
+        EXPECT_TRUE(storage.create());
+
+        EXPECT_TRUE(storage.set({{"Key 1", "Value 1"}}, Core::Storage::Storage::SYNC));
+        EXPECT_TRUE(storage.set({{"Key 2", "Value 2"}}, Core::Storage::Storage::PERIODIC));
+        EXPECT_TRUE(storage.set({{"Key 3", "Value 3"}}, Core::Storage::Storage::ASYNC));
+
+        EXPECT_TRUE(storage.sync());
+        EXPECT_TRUE(storage.sync());
+    }
+
+    Core::Storage::Storage storage(path);
+
+    EXPECT_TRUE(storage.open());
+
+    for (size_t i = 1; i <= 3; i++)
+    {
+        const Core::Storage::Storage::KeyValue::Ptr pair = storage.get("Key " + std::to_string(i));
+
+        EXPECT_TRUE(pair);
+
+        EXPECT_EQ(pair->getValue(), "Value " + std::to_string(i));
+    }
+
+    EXPECT_TRUE(storage.close());
+    EXPECT_TRUE(storage.remove());
+}
+
+TEST_F(StorageTest, Scan)
+{
+    Core::Storage::Storage storage(makeTempPath());
+
+    EXPECT_TRUE(storage.create());
+
+    EXPECT_TRUE(storage.set({
+        {"A/1", "Value A1"},
+        {"B/1", "Value B1"},
+        {"B/2", "Value B2"},
+        {"B/3", "Value B3"},
+        {"C/1", "Value C1"}
+    }));
+
+    {
+        const Core::Storage::Storage::Iterator::Ptr it = storage.scan("B/");
+
+        EXPECT_TRUE(it);
+
+        std::vector<std::string> keys;
+
+        for (; it->isValid(); it->next())
+        {
+            keys.push_back(it->getKey());
+
+            EXPECT_EQ(it->getValue(), "Value B" + keys.back().substr(2));
+        }
+
+        EXPECT_TRUE(it->getStatus());
+
+        EXPECT_EQ(keys, std::vector<std::string>({"B/1", "B/2", "B/3"}));
+
+        it->seek("B/2");
+
+        EXPECT_TRUE(it->isValid());
+        EXPECT_EQ(it->getKey(), "B/2");
+
+        it->seek("A/1");
+
+        EXPECT_TRUE(it->isValid());
+        EXPECT_EQ(it->getKey(), "B/1");
+    }
+
+    {
+        Core::Storage::Storage::ReadOptions options;
+
+        options.fillCache = false;
+        options.readahead = SCAN_READAHEAD;
+
+        const Core::Storage::Storage::Iterator::Ptr it = storage.scan("D/", options);
+
+        EXPECT_TRUE(it);
+        EXPECT_FALSE(it->isValid());
+    }
+
+    EXPECT_TRUE(storage.close());
+    EXPECT_TRUE(storage.remove());
+}
+
+TEST_F(StorageTest, Partition)
+{
+    const Core::Storage::Storage::Ptr storage = std::make_shared<Core::Storage::Storage>(makeTempPath());
+
+    EXPECT_TRUE(storage->create());
+
+    Core::Storage::Storage partition1(storage, "P1/");
+    Core::Storage::Storage partition2(storage, "P2/");
+
+    EXPECT_FALSE(partition1.open());
+
+    EXPECT_TRUE(partition1.create());
+    EXPECT_TRUE(partition2.create());
+
+    EXPECT_TRUE(partition1.set({{"Key 1", "Value 1"}, {"Key 2", "Value 2"}}));
+    EXPECT_TRUE(partition2.set({{"Key 1", "Value 3"}}));
+
+    EXPECT_EQ(partition1.get("Key 1")->getValue(), "Value 1");
+    EXPECT_EQ(partition2.get("Key 1")->getValue(), "Value 3");
+    EXPECT_FALSE(partition2.get("Key 2"));
+
+    EXPECT_EQ(storage->get("P1/Key 2")->getValue(), "Value 2");
+
+    {
+        const Core::Storage::Storage::Iterator::Ptr it = partition1.scan("Key ");
+
+        EXPECT_TRUE(it);
+        EXPECT_TRUE(it->isValid());
+        EXPECT_EQ(it->getKey(), "Key 1");
+
+        it->next();
+
+        EXPECT_TRUE(it->isValid());
+        EXPECT_EQ(it->getKey(), "Key 2");
+
+        it->next();
+
+        EXPECT_FALSE(it->isValid());
+    }
+
+    EXPECT_TRUE(partition1.close());
+
+    Core::Storage::Storage partition3(storage, "P1/");
+
+    EXPECT_FALSE(partition3.create());
+    EXPECT_TRUE(partition3.open());
+    EXPECT_TRUE(partition3.close());
+
+    EXPECT_TRUE(partition1.remove());
+
+    EXPECT_FALSE(storage->get("P1/Key 1"));
+    EXPECT_TRUE(storage->get("P2/Key 1"));
+
+    EXPECT_FALSE(partition3.open());
+
+    EXPECT_TRUE(partition2.close());
+
+    EXPECT_TRUE(storage->close());
+    EXPECT_TRUE(storage->remove());
+}
+
+TEST_F(StorageTest, Compression)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Storage::Options options;
+
+    options.compression = Core::Storage::Storage::SNAPPY;
+
+    {
+        Core::Storage::Storage storage(path, options);
+
+        EXPECT_TRUE(storage.create());
+
+        for (size_t i = 0; i < 64; i++)
+        {
+            EXPECT_TRUE(storage.set({{"Key " + std::to_string(i), "{\"value\": \"You can\'t steer a parked car\"}"}}));
+        }
+    }
+
+    Core::Storage::Storage storage(path, options);
+
+    EXPECT_TRUE(storage.open());
+
+    const Core::Storage::Storage::KeyValue::Ptr pair = storage.get("Key 1");
+
+    EXPECT_TRUE(pair);
+    EXPECT_EQ(pair->getValue(), "{\"value\": \"You can\'t steer a parked car\"}");
+
+    uint64_t size = 0;
+
+    EXPECT_TRUE(storage.getApproximateSize("Key ", size));
+    EXPECT_TRUE(storage.getApproximateSize("", size));
+
+    EXPECT_TRUE(storage.close());
+    EXPECT_TRUE(storage.remove());
+}
+
+TEST_F(StorageTest, SharedCache)
+{
+    Core::Storage::Storage::Options options;
+
+    options.blockCache = Core::Storage::Storage::makeBlockCache(1 << 20);
+    options.filterPolicy = Core::Storage::Storage::makeFilterPolicy(10);
+    options.writeBufferSize = 1 << 16;
+    options.maxOpenFiles = 16;
+
+    EXPECT_TRUE(options.blockCache);
+    EXPECT_TRUE(options.filterPolicy);
+
+    EXPECT_FALSE(Core::Storage::Storage::makeBlockCache(0));
+    EXPECT_FALSE(Core::Storage::Storage::makeFilterPolicy(0));
+
+    Core::Storage::Storage storage1(makeTempPath(), options);
+    Core::Storage::Storage storage2(makeTempPath(), options);
+
+    EXPECT_TRUE(storage1.create());
+    EXPECT_TRUE(storage2.create());
+
+    EXPECT_TRUE(storage1.set({{"Key 1", "Value 1"}}));
+    EXPECT_TRUE(storage2.set({{"Key 1", "Value 2"}}));
+
+    EXPECT_EQ(storage1.get("Key 1")->getValue(), "Value 1");
+    EXPECT_EQ(storage2.get("Key 1")->getValue(), "Value 2");
+
+    EXPECT_FALSE(storage1.get("Key 2"));
+
+    EXPECT_TRUE(storage1.close());
+    EXPECT_TRUE(storage2.close());
+
+    EXPECT_TRUE(storage1.remove());
+    EXPECT_TRUE(storage2.remove());
+}
+
+TEST_F(StorageTest, MemoryBackend)
+{
+    const std::string& path = makeTempPath();
+
+    Core::Storage::Storage::Options options;
+
+    options.backend = Core::Storage::Storage::MEMORY;
+
+    {
+        Core::Storage::Storage storage(path, options);
+
+        EXPECT_FALSE(storage.exists());
+
+        EXPECT_TRUE(storage.create());
+
+        EXPECT_TRUE(storage.set({
+            {"Key 1", "Value 1"},
+            {"Key 2", "Value 2"}
+        }, Core::Storage::Storage::PERIODIC));
+
+        EXPECT_TRUE(storage.sync());
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(path));
+
+    Core::Storage::Storage storage(path, options);
+
+    EXPECT_TRUE(storage.exists());
+    EXPECT_TRUE(storage.open());
+
+    const Core::Storage::Storage::KeyValue::Ptr value = storage.get("Key 2");
+
+    EXPECT_TRUE(value);
+    EXPECT_EQ(value->getValue(), "Value 2");
+
+    EXPECT_TRUE(storage.replace({"Key 1"}, {}));
+
+    const Core::Storage::Storage::Iterator::Ptr it = storage.scan("Key ");
+
+    EXPECT_TRUE(it && it->isValid());
+    EXPECT_EQ(it->getKey(), "Key 2");
+
+    it->next();
+
+    EXPECT_FALSE(it->isValid());
+
+    EXPECT_TRUE(storage.close());
+    EXPECT_TRUE(storage.remove());
+
+    EXPECT_FALSE(storage.exists());
+}
+
+TEST_F(StorageTest, ReadStats)
+{
+    for (const Core::Storage::Storage::BackendType backend : {Core::Storage::Storage::DISK, Core::Storage::Storage::MEMORY})
+    {
+        Core::Storage::Storage::Options options;
+
+        options.backend = backend;
+
+        const Core::Storage::Storage::Ptr storage = std::make_shared<Core::Storage::Storage>(makeTempPath(), options);
+
+        EXPECT_TRUE(storage->create());
+
+        Core::Storage::Storage partition(storage, "P/");
+
+        EXPECT_TRUE(partition.create());
+
+        const std::string data(1024, 'x');
+
+        EXPECT_TRUE(partition.set({{"Key", data}}));
+
+        Core::Storage::Storage::Slice value;
+
+        EXPECT_TRUE(partition.get("Key", value));
+        EXPECT_EQ(value.getData(), data);
+
+        const Core::Storage::Storage::ReadStats stats = storage->getReadStats();
+
+        EXPECT_EQ(stats.reads, 1);
+        EXPECT_EQ(stats.bytesRead, data.size());
+        EXPECT_EQ(stats.bytesCopied, value.isPinned() ? 0 : data.size());
+
+        EXPECT_TRUE(partition.get("Key"));
+
+        EXPECT_EQ(storage->getReadStats().bytesCopied, stats.bytesCopied + (value.isPinned() ? 1 : 2) * data.size());
+
+        EXPECT_TRUE(storage->close());
+        EXPECT_TRUE(storage->remove());
+    }
+}
+
+TEST_F(StorageTest, MultiGet)
+{
+    for (const Core::Storage::Storage::BackendType backend : {Core::Storage::Storage::DISK, Core::Storage::Storage::MEMORY})
+    {
+        Core::Storage::Storage::Options options;
+
+        options.backend = backend;
+
+        const Core::Storage::Storage::Ptr storage = std::make_shared<Core::Storage::Storage>(makeTempPath(), options);
+
+        EXPECT_TRUE(storage->create());
+
+        Core::Storage::Storage partition(storage, "P/");
+
+        EXPECT_TRUE(partition.create());
+
+        EXPECT_TRUE(partition.set({{"Key 1", "Value 1"}, {"Key 2", "Value 2"}}));
+        EXPECT_TRUE(storage->set({{"Key 3", "Value 3"}}));
+
+        std::vector<Core::Storage::Storage::Slice> values;
+        Core::Storage::Storage::StatusList statuses;
+
+        EXPECT_TRUE(partition.multiGet({"Key 2", "Key 3", "Key 1"}, values, statuses));
+
+        EXPECT_EQ(values.size(), 3);
+        EXPECT_EQ(statuses, Core::Storage::Storage::StatusList({true, false, true}));
+
+        EXPECT_EQ(values[0].getData(), "Value 2");
+        EXPECT_EQ(values[2].getData(), "Value 1");
+
+        EXPECT_EQ(storage->getReadStats().reads, 2);
+
+        EXPECT_TRUE(storage->close());
+        EXPECT_TRUE(storage->remove());
+    }
+}
+
+TEST_F(StorageTest, OptionalGet)
+{
+    for (const Core::Storage::Storage::BackendType backend : {Core::Storage::Storage::DISK, Core::Storage::Storage::MEMORY})
+    {
+        Core::Storage::Storage::Options options;
+
+        options.backend = backend;
+
+        const Core::Storage::Storage::Ptr storage = std::make_shared<Core::Storage::Storage>(makeTempPath(), options);
+
+        EXPECT_TRUE(storage->create());
+
+        Core::Storage::Storage partition(storage, "P/");
+
+        EXPECT_TRUE(partition.create());
+        EXPECT_TRUE(partition.set({{"Key 1", "Value 1"}}));
+
+        getLogData();
+
+        Core::Storage::Storage::Slice value;
+        bool isFound = false;
+
+        EXPECT_TRUE(partition.get("Key 1", value, isFound));
+        EXPECT_TRUE(isFound);
+        EXPECT_EQ(value.getData(), "Value 1");
+
+        EXPECT_TRUE(partition.get("Key 2", value, isFound));
+        EXPECT_FALSE(isFound);
+
+        EXPECT_EQ(getLogData(), "");
+        EXPECT_EQ(storage->getReadStats().reads, 1);
+
+        EXPECT_FALSE(partition.get("Key 2", value));
+
+        EXPECT_TRUE(storage->close());
+        EXPECT_TRUE(storage->remove());
+    }
+}
+
+TEST_F(StorageTest, Ingest)
+{
+    for (const Core::Storage::Storage::BackendType backend : {Core::Storage::Storage::DISK, Core::Storage::Storage::MEMORY})
+    {
+        Core::Storage::Storage::Options options;
+
+        options.backend = backend;
+
+        const Core::Storage::Storage::Ptr storage = std::make_shared<Core::Storage::Storage>(makeTempPath(), options);
+
+        EXPECT_TRUE(storage->create());
+
+        Core::Storage::Storage partition(storage, "P/");
+
+        EXPECT_TRUE(partition.create());
+
+        EXPECT_TRUE(partition.set({{"Key 2", "Value 1"}}));
+
+        EXPECT_TRUE(partition.ingest({{"Key 3", "Value 3"}, {"Key 1", "Value 1"}, {"Key 2", "Value 2"}}));
+        EXPECT_TRUE(partition.ingest({}));
+
+        const Core::Storage::Storage::Iterator::Ptr it = partition.scan("");
+
+        EXPECT_TRUE(it);
+
+        for (size_t i = 1; i <= 3; i++, it->next())
+        {
+            EXPECT_TRUE(it->isValid());
+            EXPECT_EQ(it->getKey(), "Key " + std::to_string(i));
+            EXPECT_EQ(it->getValue(), "Value " + std::to_string(i));
+        }
+
+        EXPECT_FALSE(it->isValid());
+
+        EXPECT_TRUE(storage->close());
+        EXPECT_TRUE(storage->remove());
+    }
+}
+
+TEST_F(StorageTest, Checkpoint)
+{
+    for (const Core::Storage::Storage::BackendType backend : {Core::Storage::Storage::DISK, Core::Storage::Storage::MEMORY})
+    {
+        Core::Storage::Storage::Options options;
+
+        options.backend = backend;
+
+        const Core::Storage::Storage::Ptr storage = std::make_shared<Core::Storage::Storage>(makeTempPath(), options);
+
+        EXPECT_TRUE(storage->create());
+
+        Core::Storage::Storage partition(storage, "P/");
+
+        EXPECT_TRUE(partition.create());
+
+        EXPECT_TRUE(storage->set({{"Key 1", "Value 1"}}));
+        EXPECT_TRUE(partition.set({{"Key 2", "Value 2"}}));
+
+        const std::string& path = makeTempPath();
+        const std::string& partitionPath = makeTempPath();
+
+        EXPECT_TRUE(storage->checkpoint(path));
+        EXPECT_TRUE(partition.checkpoint(partitionPath));
+
+        EXPECT_TRUE(storage->set({{"Key 3", "Value 3"}}));
+
+        Core::Storage::Storage checkpoint(path, options);
+
+        EXPECT_TRUE(checkpoint.open());
+
+        EXPECT_TRUE(checkpoint.get("Key 1"));
+        EXPECT_TRUE(checkpoint.get("P/Key 2"));
+        EXPECT_FALSE(checkpoint.get("Key 3"));
+
+        Core::Storage::Storage partitionCheckpoint(partitionPath, options);
+
+        EXPECT_TRUE(partitionCheckpoint.open());
+
+        EXPECT_FALSE(partitionCheckpoint.get("Key 1"));
+        EXPECT_TRUE(partitionCheckpoint.get("Key 2"));
+
+        Core::Storage::Storage copy(storage, "C/");
+
+        EXPECT_TRUE(copy.create());
+        EXPECT_TRUE(partition.copy(copy));
+
+        EXPECT_TRUE(copy.get("Key 2"));
+
+        EXPECT_TRUE(checkpoint.close());
+        EXPECT_TRUE(checkpoint.remove());
+
+        EXPECT_TRUE(partitionCheckpoint.close());
+        EXPECT_TRUE(partitionCheckpoint.remove());
+
+        EXPECT_TRUE(storage->close());
+        EXPECT_TRUE(storage->remove());
+    }
 }
\ No newline at end of file